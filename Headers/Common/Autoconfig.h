@@ -0,0 +1,34 @@
+#ifndef AUTOCONFIG
+#define AUTOCONFIG
+
+#define AUTO_PROFILE_FILE "Resources/working_ratios.txt"
+#define AUTO_DECIMALS_STEP 10000            // Decimals between the columns of a profile without a "# step" line
+#define AUTO_MIN_GAIN 0.01                  // Time saved that is worth more workers or another algorithm
+#define AUTO_NUM_ALGORITHMS 13              // Algorithm ids that a profile can have sequential times of
+#define AUTO_OMP 0                          // Back ends
+#define AUTO_MPI 1
+
+typedef struct {
+    int num_workers, num_points;            // Rows (1, 2... workers) and columns (precisions) of the profile
+    long decimals_step;                     // The column c is measured with (c + 1) decimals_step decimals
+    double * ratios;                        // num_workers x num_points timing ratios, 0 if not measured
+    double * seconds[AUTO_NUM_ALGORITHMS];  // Measured sequential seconds per column, NULL if none
+    int seconds_points[AUTO_NUM_ALGORITHMS];
+} profile_t;
+
+typedef struct {
+    int algorithm, num_threads, num_procs;
+    double speed_up;                        // Over one worker, from the profile
+    double expected_time;                   // Seconds, from the sequential time of the algorithm
+} autoconfig_t;
+
+int read_profile(const char * file_name, profile_t * profile);
+void free_profile(profile_t * profile);
+double profile_speed_up(const profile_t * profile, int num_workers, int precision);
+double sequential_seconds(const profile_t * profile, int algorithm, int precision);
+int host_cores();
+void auto_configure(const char * file_name, int backend, int precision, int num_procs, int max_threads,
+                        int algorithm, int num_threads, autoconfig_t * config);
+void print_autoconfig(const char * file_name, autoconfig_t * config);
+
+#endif
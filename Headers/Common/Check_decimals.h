@@ -1,7 +1,14 @@
 #ifndef CHECK_DECIMALS
 #define CHECK_DECIMALS
 
-int check_decimals(mpfr_t pi);
+#define REFERENCE_DECIMALS 1000000      // Decimals in Resources/numeroPiCorrecto.txt
+#define REFERENCE_FILE "Resources/numeroPiCorrecto.txt"
+#define CHECK_BLOCK_BYTES (1L << 20)    // Bytes compared by a thread at a time
+
+char * map_file(const char * file_name, long * length);
+void unmap_file(char * data, long length);
+long find_first_mismatch(const char * a, const char * b, long length, int num_threads);
+int check_decimals(mpfr_t pi, int num_threads);
 
 #endif
 
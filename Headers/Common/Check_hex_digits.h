@@ -0,0 +1,10 @@
+#ifndef CHECK_HEX_DIGITS
+#define CHECK_HEX_DIGITS
+
+#define HEX_SPOT_CHECKS 2                   // Extractions at the middle and at the tail
+
+void set_hex_verification(int enabled);
+int get_hex_verification();
+int check_hex_digits(mpfr_t pi, int precision, int num_threads);
+
+#endif
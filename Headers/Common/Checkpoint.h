@@ -0,0 +1,56 @@
+#ifndef CHECKPOINT
+#define CHECKPOINT
+
+#include <stdint.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#define CHECKPOINT_MAGIC "PICKPT01"
+#ifndef CHECKPOINT_INTERVAL
+#define CHECKPOINT_INTERVAL 60              // Seconds between checkpoints
+#endif
+#define CHECKPOINT_MAX_VALUES 4             // Partial sum and recurrence state of a worker
+
+#define CHECKPOINT_BBP 0                    // Series that can be checkpointed (ids of the algorithms)
+#define CHECKPOINT_CHUDNOVSKY 3
+
+typedef struct {
+    char magic[8];
+    int64_t algorithm, num_values, num_iterations, precision_bits, taper;
+    int64_t num_units;
+    int64_t slot_bytes;                     // Size of each copy of the state of a unit
+    uint64_t hash;                          // Of the header (without it) and the blocks of the units
+} checkpoint_header_t;
+
+typedef struct {
+    long start, end;                        // Block of iterations of the unit
+    long next;                              // First iteration that is not in the saved state, -1 if none
+    long sequence;                          // Last copy of the state written
+    int requested;                          // Set by the writer thread, cleared when the state is staged (atomic)
+    int staged;                             // The state in the staging buffer has not been written
+    char * staging;
+} checkpoint_unit_t;
+
+typedef struct {
+    int enabled;                            // There is a checkpoint file
+    int algorithm, num_values, num_units;
+    long num_iterations, precision_bits, slot_bytes, header_bytes;
+    checkpoint_unit_t * units;
+    int first_unit, last_unit;              // Units written by this process
+    int fd, closing;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+} checkpoint_t;
+
+void set_checkpoint_file(const char * file_name, int resume);
+const char * get_checkpoint_file();
+void checkpoint_begin(checkpoint_t * checkpoint, int algorithm, int num_iterations, int num_units, long precision_bits,
+                        double bits_per_term, int num_values, int main_process);
+void checkpoint_start(checkpoint_t * checkpoint, int first_unit, int last_unit);
+long checkpoint_restore(checkpoint_t * checkpoint, int unit, mpfr_ptr x, ...);
+void checkpoint_save(checkpoint_t * checkpoint, int unit, long next, mpfr_ptr x, ...);
+void checkpoint_end(checkpoint_t * checkpoint);
+void checkpoint_remove(checkpoint_t * checkpoint);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef DECIMAL_CONVERSION
+#define DECIMAL_CONVERSION
+
+#define CONVERSION_BASE_DIGITS 2048         // Smaller pieces are converted by mpz_get_str
+#define CONVERSION_MIN_TASK_DIGITS 65536    // Smaller pieces are not worth a task
+#define CONVERSION_MAX_LEVELS 48
+
+typedef void (* decimals_sink_t)(const char * digits, long length, void * data);
+
+long decimal_buffer_size(mpfr_t x, long num_decimals);
+void mpz_get_decimals(char * buffer, mpz_t z, long length, int num_threads);
+void mpz_stream_decimals(mpz_t z, long length, long chunk_digits, int num_threads, 
+                            decimals_sink_t sink, void * data);
+long mpfr_get_scaled_decimals(mpz_t z, mpfr_t x, long num_decimals, int * negative);
+long mpfr_get_decimals(char * buffer, mpfr_t x, long num_decimals, int num_threads);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef DIVISION_KERNEL
+#define DIVISION_KERNEL
+
+#include <stdint.h>
+
+#define DIVISION_KERNEL_AUTO 0              // Best kernel supported by the CPU
+#define DIVISION_KERNEL_MPN 1               // One mpn_divrem_1 per divisor
+#define DIVISION_KERNEL_SCALAR 2
+#define DIVISION_KERNEL_AVX2 3
+#define DIVISION_KERNEL_AVX512 4
+
+#define DIVISION_MAX_LANES 16
+#define DIVISION_DIGIT_BITS 32
+#define DIVISION_MAX_DIVISOR 2147483647     // Divisors and remainders fit in 31 bits
+
+typedef struct {
+    int num_lanes;
+    uint64_t rem[DIVISION_MAX_LANES];       // Remainder of each division
+    uint64_t divisor[DIVISION_MAX_LANES];
+    double inverse[DIVISION_MAX_LANES];     // 2^32 / divisor
+    int64_t negative[DIVISION_MAX_LANES];   // -1 if the quotient is subtracted, 0 if added
+} division_lanes_t;
+
+int division_kernel_supported(int kernel);
+int set_division_kernel(int kernel);
+int get_division_kernel();
+int division_kernel_from_name(const char * name);
+const char * division_kernel_name(int kernel);
+void division_lane(division_lanes_t * lanes, uint64_t rem, uint64_t divisor, int negative);
+void division_kernel(int64_t * digits, long num_digits, division_lanes_t * lanes);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef MANIFEST
+#define MANIFEST
+
+#include <stdint.h>
+
+#define MANIFEST_MAGIC "PIMANIFEST"
+#define MANIFEST_CHUNK_DIGITS 1048576       // Default decimals hashed together
+#define MANIFEST_HASH_SEED 0
+#define MANIFEST_STREAM_DIGITS (4L << 20)   // Digits converted at a time while checking
+
+typedef struct {
+    long chunk_digits;
+    long num_decimals;                      // Decimals covered by the manifest
+    long num_chunks;                        // The last one may be shorter
+    uint64_t * hashes;
+} manifest_t;
+
+void set_manifest_file(const char * file_name);
+const char * get_manifest_file();
+void hash_chunks(const char * decimals, long num_decimals, long chunk_digits, uint64_t * hashes, int num_threads);
+int write_manifest(const char * file_name, const manifest_t * manifest);
+int read_manifest(const char * file_name, manifest_t * manifest);
+void free_manifest(manifest_t * manifest);
+int check_manifest_length(const char * file_name, long precision);
+long check_manifest(const char * file_name, mpfr_t pi, long precision, int num_threads);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef OPTIONS
+#define OPTIONS
+
+typedef struct {
+    int taper;                  // --taper: per-term working precision
+    int kernel;                 // --kernel=NAME: division kernel of the fixed point algorithms
+    char * output;              // --output=FILE: file where the decimals are written, NULL if none
+    char * manifest;            // --manifest=FILE: reference manifest to check the decimals, NULL if none
+    char * checkpoint;          // --checkpoint=FILE: file of the periodic checkpoints, NULL if none
+    int resume;                 // --resume: continue from the checkpoint file
+    char * profile;             // --profile=FILE: timing ratios of the auto configuration
+    int algorithm;              // --algorithm=N: algorithm kept by the auto configuration, -1 if none
+    int threads;                // --threads=N: threads kept by the auto configuration, 0 if none
+    int report;                 // --report=FORMAT: format of the phase times, text or json
+    int verify_hex;             // --verify=hex: hex spot checks of the runs longer than the reference
+} options_t;
+
+int parse_options(int argc, char ** argv, int first_option, options_t * options);
+void print_options_usage();
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef OUTPUT
+#define OUTPUT
+
+void set_output_file(const char * file_name);
+const char * get_output_file();
+void write_decimals(const char * file_name, mpfr_t pi, long num_decimals, int num_threads);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef PLANNER
+#define PLANNER
+
+#define PLAN_SAFETY_BITS 16                 // Margin over the rounding error bound
+#define PLAN_FINAL_ROUNDINGS 8              // Operations after the summation (sqrt, divisions...)
+#define BITS_PER_DECIMAL 3.321928094887362  // log2(10)
+
+typedef struct {
+    int num_iterations;                     // Terms (or AGM iterations) of the algorithm
+    long precision_bits;                    // Working precision
+    long guard_bits;                        // Bits of the working precision beyond the target
+    int planned_decimals;                   // Decimals that the plan guarantees
+} plan_t;
+
+void plan_algorithm(int algorithm, int precision, plan_t * plan);
+void print_plan(plan_t * plan);
+void print_certified_decimals(plan_t * plan, int decimals_computed);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef PRECISION
+#define PRECISION
+
+#define BBP_BITS_PER_TERM 4.0               // Terms decrease by 16 
+#define BELLARD_BITS_PER_TERM 10.0          // Terms decrease by 1024 
+#define CHUDNOVSKY_BITS_PER_TERM 47.11      // Terms decrease by 151931373056000 
+#define TAPER_GUARD_BITS 64                 // Bits lost by the rounding errors of the recurrences
+#define TAPER_MIN_PRECISION 128
+#define COST_PROBE_SECONDS 0.002            // Minimum length of each probe of the cost model
+#define COST_PROBE_MAX_TERMS 65536
+#define COST_PROBE_FIRST_TERM 1000          // Index of the first term of the probes
+#define COST_MIN_EXPONENT 1.0               // Linear (small precisions) to quadratic (schoolbook products)
+#define COST_MAX_EXPONENT 2.0
+
+typedef void (* term_probe_t)(long working_precision, int num_terms);     // Computes num_terms terms
+
+void set_precision_tapering(int enabled);
+int get_precision_tapering();
+void set_cost_model(double exponent, double overhead);
+void get_cost_model(double * exponent, double * overhead);
+void calibrate_cost_model(term_probe_t probe, long precision_bits);
+long term_precision(long precision_bits, long n, double bits_per_term);
+void set_term_precision(long precision, mpfr_ptr x, ...);
+void round_term_precision(long precision, mpfr_ptr x, ...);
+void even_block(int range_start, int range_end, int num_blocks, int block_id, int * block_start, int * block_end);
+void taper_block(int range_start, int range_end, int num_blocks, int block_id, 
+                    long precision_bits, double bits_per_term, int * block_start, int * block_end);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef REPORT
+#define REPORT
+
+#define PHASE_SEEDING 0                     // Phases of a run, timed per thread
+#define PHASE_SERIES 1
+#define PHASE_THREAD_REDUCTION 2
+#define PHASE_MPI_REDUCTION 3
+#define PHASE_FINAL 4
+#define PHASE_CONVERSION 5
+#define PHASE_VERIFICATION 6
+#define PHASE_OUTPUT 7
+#define NUM_PHASES 8
+#define PHASE_MAX_THREADS 256               // Threads of a process with their own timers
+
+#define REPORT_TEXT 0
+#define REPORT_JSON 1
+
+typedef struct {
+    const char * version;                   // Sequential, OMP or MPI
+    int algorithm, precision, num_iterations, num_threads, num_procs, taper;
+    long precision_bits;
+    double execution_time;
+    int decimals_computed;                  // -1 if they were not compared with a reference
+} run_report_t;
+
+void set_report_format(int format);
+int get_report_format();
+int report_format_from_name(const char * name);
+void reset_phases(int num_threads);
+double phase_begin();
+void phase_end(int phase, int thread_id, double started);
+void phase_add(int phase, int thread_id, double seconds);
+void phase_add_rest(int phase, int timed_phase, double seconds);
+double phase_seconds(int phase, int thread_id);
+void add_stolen_chunks(int chunks);
+int phase_recorded(int phase);
+void get_phase_times(int num_threads, double * seconds, int * calls);
+void print_report(const run_report_t * run, const double * seconds, const int * calls);
+void print_process_report(const run_report_t * run);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef SCHEDULER
+#define SCHEDULER
+
+#include <pthread.h>
+
+#define SCHEDULE_CHUNKS_PER_THREAD 8        // Chunks of iterations per thread that can be stolen
+
+typedef struct {
+    int next, end;                          // Chunks of the thread that nobody has taken yet
+    int stolen;                             // Chunks taken from other threads
+} schedule_thread_t;
+
+typedef struct {
+    int num_threads;
+    schedule_thread_t * threads;
+    pthread_mutex_t lock;
+} schedule_t;
+
+int schedule_chunks(int num_iterations, int num_threads);
+void schedule_init(schedule_t * schedule, int num_chunks, int num_threads);
+int schedule_next(schedule_t * schedule, int thread_id);
+void schedule_clear(schedule_t * schedule);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef SEEDS
+#define SEEDS
+
+#include <gmp.h>
+#include <mpfr.h>
+
+#define SEED_TASK_TERMS 2048                // Terms of the product tree below which there are no more tasks
+
+typedef void (* term_ratio_t)(mpz_t p, mpz_t q, long k);    // x(k + 1) / x(k) = p / q
+
+void segment_ratio(mpfr_t r, long a, long b, term_ratio_t ratio, long precision_bits);
+void seed_recurrence(mpfr_t * seeds, const long * starts, int num_seeds, term_ratio_t ratio, 
+                        long precision_bits, int num_threads);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef WRITER
+#define WRITER
+
+#include <pthread.h>
+
+#define WRITER_BUFFERS 4                    // Chunks that can wait for the writer thread
+#define WRITER_CHUNK_BYTES (4L << 20)
+#define WRITER_ALIGNMENT 4096               // O_DIRECT needs aligned buffers, offsets and sizes
+
+typedef struct {
+    int fd;
+    int direct;                             // The file was opened with O_DIRECT
+    int error;                              // Set by the writer thread if a write fails
+    int closing;
+    long offset;                            // File offset of the next chunk
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t full, empty;
+    char * buffers[WRITER_BUFFERS];
+    long lengths[WRITER_BUFFERS];
+    int first_full, num_full;               // Queue of chunks waiting to be written
+    int current;                            // Chunk being filled
+    long fill;
+} writer_t;
+
+int writer_open(writer_t * writer, const char * file_name);
+void writer_write(writer_t * writer, const char * data, long length);
+int writer_close(writer_t * writer);
+
+#endif
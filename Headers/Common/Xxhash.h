@@ -0,0 +1,9 @@
+#ifndef XXHASH
+#define XXHASH
+
+#include <stdint.h>
+#include <stddef.h>
+
+uint64_t xxhash64(const void * data, size_t length, uint64_t seed);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef BBP_DIGITS_MPI
+#define BBP_DIGITS_MPI
+
+void BBP_hex_digits_MPI(int num_procs, int proc_id, char * hex, long position, int num_threads);
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef CHUDNOVSKY_BS_MPI
+#define CHUDNOVSKY_BS_MPI
+
+void Chudnovsky_algorithm_bs_MPI(int num_procs, int proc_id, mpfr_t pi, 
+                                int num_iterations, int num_threads, int precision_bits);
+
+#endif
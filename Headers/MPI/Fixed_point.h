@@ -0,0 +1,7 @@
+#ifndef FIXED_POINT_MPI
+#define FIXED_POINT_MPI
+
+void Fixed_point_algorithm_MPI(int num_procs, int proc_id, mpfr_t pi, const fixed_series_t * series,
+                                int num_iterations, int num_threads, int precision_bits);
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef MACHIN_MPI
+#define MACHIN_MPI
+
+void Machin_algorithm_MPI(int num_procs, int proc_id, mpfr_t pi, const machin_t * formula,
+                                int precision, int num_threads, int precision_bits);
+
+#endif
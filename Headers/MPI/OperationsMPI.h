@@ -1,9 +1,14 @@
 #ifndef OPERATIONS_MPI
 #define OPERATIONS_MPI
 
+#include "../Common/Precision.h"
+
 void add(void *, void *, int *, MPI_Datatype *);
 void mul(void *, void *, int *, MPI_Datatype *);
 int pack(void *, mpfr_t);
 void unpack(void *, mpfr_t);
+void send_mpz(mpz_t, int, int);
+void recv_mpz(mpz_t, int, int);
+void calibrate_cost_model_MPI(int proc_id, term_probe_t probe, long precision_bits);
 
 #endif
@@ -0,0 +1,9 @@
+#ifndef OUTPUT_MPI
+#define OUTPUT_MPI
+
+#define OUTPUT_CHUNK_CHARS (16L << 20)      // Chars written by every collective call
+
+void write_decimals_MPI(int num_procs, int proc_id, const char * file_name, mpfr_t pi, 
+                            long num_decimals, int num_threads);
+
+#endif
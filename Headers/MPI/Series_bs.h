@@ -0,0 +1,9 @@
+#ifndef SERIES_BS_MPI
+#define SERIES_BS_MPI
+
+void Series_bs_threads(const series_t * series, int block_start, int block_end, int num_threads,
+                                    mpz_t P_block, mpz_t Q_block, mpz_t B_block, mpz_t T_block);
+void Series_algorithm_bs_MPI(int num_procs, int proc_id, mpfr_t result, const series_t * series,
+                                    int num_iterations, int num_threads);
+
+#endif
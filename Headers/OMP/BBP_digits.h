@@ -0,0 +1,6 @@
+#ifndef BBP_DIGITS_OMP
+#define BBP_DIGITS_OMP
+
+void BBP_hex_digits_OMP(char * hex, long position, int num_threads);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef CHUDNOVSKY_BS_OMP
+#define CHUDNOVSKY_BS_OMP
+
+void mpz_mul_OMP(mpz_t r, mpz_t x, mpz_t y, int pieces);
+void Chudnovsky_bs_OMP(int a, int b, mpz_t P, mpz_t Q, mpz_t T, int threads, int grain, int need_P);
+void Chudnovsky_algorithm_bs_OMP(mpfr_t pi, int num_iterations, int num_threads, int precision_bits);
+
+#endif
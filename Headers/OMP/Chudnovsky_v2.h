@@ -0,0 +1,7 @@
+#ifndef CHUDNOVSKY_V2_OMP
+#define CHUDNOVSKY_V2_OMP
+
+void Chudnovsky_algorithm_v2_OMP(mpfr_t pi, int num_iterations, int num_threads, int);
+
+#endif
+
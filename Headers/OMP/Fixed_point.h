@@ -0,0 +1,7 @@
+#ifndef FIXED_POINT_OMP
+#define FIXED_POINT_OMP
+
+void Fixed_point_algorithm_OMP(mpfr_t pi, const fixed_series_t * series, int num_iterations,
+                                    int num_threads, int precision_bits);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef GAUSS_LEGENDRE_OMP
+#define GAUSS_LEGENDRE_OMP
+
+void mpfr_mul_OMP(mpfr_t r, mpfr_t x, mpfr_t y, int pieces);
+void mpfr_sqrt_OMP(mpfr_t result, mpfr_t x, int pieces);
+void GaussLegendre_algorithm_OMP(mpfr_t pi, int num_iterations, int num_threads, int precision_bits);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef MACHIN_OMP
+#define MACHIN_OMP
+
+void Machin_algorithm_OMP(mpfr_t pi, const machin_t * formula, int precision, int num_threads);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef SERIES_BS_OMP
+#define SERIES_BS_OMP
+
+void Series_bs_OMP(const series_t * series, int a, int b, mpz_t P, mpz_t Q, mpz_t B, mpz_t T, 
+                    int threads, int grain);
+void Series_algorithm_bs_OMP(mpfr_t result, const series_t * series, int num_iterations, int num_threads);
+
+#endif
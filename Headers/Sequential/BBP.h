@@ -3,6 +3,7 @@
 
 void BBP_iteration(mpfr_t , int, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t);
 void BBP_algorithm(mpfr_t , int);
+void BBP_probe(long working_precision, int num_terms);
 
 #endif
 
@@ -0,0 +1,12 @@
+#ifndef BBP_DIGITS
+#define BBP_DIGITS
+
+#define BBP_HEX_DIGITS 8            // Hex digits given by each extraction
+#define BBP_TAIL_TERMS 24           // Terms with k > position that are added
+
+unsigned long pow16_mod(unsigned long exponent, unsigned long modulus);
+long double BBP_digits_partial(long position, long k_start, long k_end);
+void BBP_fraction_to_hex(char * hex, long double fraction);
+void BBP_hex_digits(char * hex, long position);
+
+#endif
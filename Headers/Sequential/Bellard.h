@@ -2,6 +2,7 @@
 #define BELLARD
 
 void Bellard_algorithm(mpfr_t, int);
+void Bellard_probe(long working_precision, int num_terms);
 
 #endif
 
@@ -3,6 +3,7 @@
 
 void Bellard_iteration_v1(mpfr_t, int, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, int, int);
 void Bellard_algorithm_v1(mpfr_t, int);
+void Bellard_v1_probe(long working_precision, int num_terms);
 
 #endif
 
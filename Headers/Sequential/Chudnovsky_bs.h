@@ -0,0 +1,10 @@
+#ifndef CHUDNOVSKY_BS
+#define CHUDNOVSKY_BS
+
+void Chudnovsky_bs_leaf(int a, mpz_t P, mpz_t Q, mpz_t T);
+void Chudnovsky_bs_merge(mpz_t P, mpz_t Q, mpz_t T, mpz_t P2, mpz_t Q2, mpz_t T2, int need_P);
+void Chudnovsky_bs(int a, int b, mpz_t P, mpz_t Q, mpz_t T);
+void Chudnovsky_bs_pi(mpfr_t pi, mpz_t Q, mpz_t T);
+void Chudnovsky_algorithm_bs(mpfr_t pi, int num_iterations);
+
+#endif
@@ -1,8 +1,24 @@
 #ifndef CHUDNOVSKY
 #define CHUDNOVSKY
 
+#include <gmp.h>
+#include "../Common/Checkpoint.h"
+
+typedef struct {
+    int num_seeds;
+    long * starts;                          // First iteration of the seeded units, increasing
+    mpfr_t * dep_a;                         // dep_a at each start
+} Chudnovsky_seeds_t;
+
 void Chudnovsky_algorithm_v2(mpfr_t, int);
 void Chudnovsky_iteration(mpfr_t, int, mpfr_t, mpfr_t, mpfr_t, mpfr_t);
+void Chudnovsky_update_a(mpfr_t dep_a, int n, mpfr_t dividend, mpfr_t divisor);
+void Chudnovsky_probe(long working_precision, int num_terms);
+void Chudnovsky_ratio_a(mpz_t p, mpz_t q, long k);
+void init_Chudnovsky_seeds(Chudnovsky_seeds_t * seeds, checkpoint_t * checkpoint, const int * units, int num_units, 
+                            long precision_bits, int num_threads);
+void set_Chudnovsky_seed(Chudnovsky_seeds_t * seeds, checkpoint_t * checkpoint, int unit, long precision_bits, 
+                            mpfr_t dep_a, mpfr_t dep_b, mpfr_t dep_c);
+void clear_Chudnovsky_seeds(Chudnovsky_seeds_t * seeds);
 
 #endif
-
@@ -0,0 +1,33 @@
+#ifndef FIXED_POINT
+#define FIXED_POINT
+
+#define FIXED_POINT_MAX_COMPONENTS 8
+#define FIXED_POINT_GUARD_LIMBS 1           // Absorb the truncation error of every division
+
+typedef struct {
+    int sign;                               // +1 or -1
+    int log2_coeff;                         // Numerator 2^log2_coeff
+    long den_a, den_b;                      // Denominator den_a n + den_b
+} fixed_component_t;
+
+typedef struct {
+    int log2_ratio;                         // term(n) is divided by 2^(log2_ratio n)
+    int log2_scale;                         // The whole sum is multiplied by 2^log2_scale
+    int alternating;                        // Odd terms change their sign
+    int num_components;
+    fixed_component_t components[FIXED_POINT_MAX_COMPONENTS];
+} fixed_series_t;
+
+extern const fixed_series_t BBP_fixed_series;
+extern const fixed_series_t Bellard_fixed_series;
+
+mp_size_t Fixed_point_size(long precision_bits);
+void Fixed_point_add_term(mp_ptr sum, mp_size_t size, const fixed_series_t * series, long n, mp_ptr quotient);
+void Fixed_point_add_digits(mp_ptr sum, mp_size_t size, const int64_t * digits, long num_digits);
+long Fixed_point_add_batch(mp_ptr sum, mp_size_t size, const fixed_series_t * series, long first, long last, 
+                                long step, int64_t * digits);
+void Fixed_point_sum(mp_ptr sum, mp_size_t size, const fixed_series_t * series, long first, long last, long step);
+void Fixed_point_to_mpfr(mpfr_t result, mp_srcptr sum, mp_size_t size);
+void Fixed_point_algorithm(mpfr_t pi, const fixed_series_t * series, int num_iterations);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef GAUSS_LEGENDRE
+#define GAUSS_LEGENDRE
+
+void GaussLegendre_iteration(mpfr_t a, mpfr_t b, mpfr_t t, int log_p, mpfr_t aux);
+void GaussLegendre_pi(mpfr_t pi, mpfr_t a, mpfr_t b, mpfr_t t);
+void GaussLegendre_algorithm(mpfr_t pi, int num_iterations);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef MACHIN
+#define MACHIN
+
+#define MACHIN_MAX_TERMS 4
+
+typedef struct {
+    int num_terms;
+    long coeffs[MACHIN_MAX_TERMS];          // pi / 4 = SUM(coeffs[j] arctan(1 / ks[j]))
+    long ks[MACHIN_MAX_TERMS];
+} machin_t;
+
+extern const machin_t Takano_formula;
+extern const machin_t Stormer_formula;
+
+void arctan_series(series_t * series, long k);
+int arctan_iterations(long k, int precision);
+int Machin_iterations(const machin_t * formula, int precision);
+void Machin_term_value(mpfr_t result, const machin_t * formula, int j, mpz_t Q, mpz_t B, mpz_t T);
+void Machin_algorithm(mpfr_t pi, const machin_t * formula, int precision);
+
+#endif
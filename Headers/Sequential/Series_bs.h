@@ -0,0 +1,26 @@
+#ifndef SERIES_BS
+#define SERIES_BS
+
+#define SERIES_MAX_DEGREE 8
+
+typedef struct {
+    int degree;
+    long coeffs[SERIES_MAX_DEGREE + 1];     // coeffs[i] multiplies n^i
+} polynomial_t;
+
+typedef struct {
+    polynomial_t a, b;                      // term(n) = r(1) r(2) ... r(n) a(n) / b(n)
+    polynomial_t p, q;                      // r(k) = p(k) / q(k), k >= 1
+} series_t;
+
+extern const series_t BBP_series;
+extern const series_t Bellard_series;
+
+void polynomial_eval(mpz_t result, const polynomial_t * poly, int n);
+void Series_bs_leaf(const series_t * series, int n, mpz_t P, mpz_t Q, mpz_t B, mpz_t T);
+void Series_bs_merge(mpz_t P, mpz_t Q, mpz_t B, mpz_t T, mpz_t P2, mpz_t Q2, mpz_t B2, mpz_t T2);
+void Series_bs(const series_t * series, int a, int b, mpz_t P, mpz_t Q, mpz_t B, mpz_t T);
+void Series_bs_value(mpfr_t result, mpz_t Q, mpz_t B, mpz_t T);
+void Series_algorithm_bs(mpfr_t result, const series_t * series, int num_iterations);
+
+#endif
@@ -0,0 +1,252 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "../../Headers/Common/Autoconfig.h"
+
+
+/************************************************************************************
+ * Runtime auto configuration                                                       *
+ * A profile is a table of measured timing ratios: the row w is the run with w      *
+ * workers (threads times processes) and the column c the run with (c + 1) step     *
+ * decimals. A zero means that it was not measured (too many workers for so few     *
+ * decimals). The speed-up of w workers is ratio(1) / ratio(w), interpolated        *
+ * linearly between the two closest columns:                                        *
+ *                                                                                  *
+ *      # step 10000                                                                *
+ *      # seconds 4  0.012  0.031  0.055 ...    <- 1 worker of algorithm 4          *
+ *      59.500  35.000  21.350 ...          <- 1 worker                             *
+ *      40.500  24.500  14.350 ...          <- 2 workers                            *
+ *                                                                                  *
+ * The expected time of a configuration is the sequential time of the algorithm     *
+ * divided by the speed-up. The sequential times are the "# seconds" rows that      *
+ * benchmark.sh measures on the host, interpolated in the same way and scaled with  *
+ * the exponent below beyond the measured precisions. Without them, it is a power   *
+ * of the decimals fitted to runs between 5000 and 400000 decimals on another host. *
+ * The chosen one is the fastest that the cores of the host can run                 *
+ *                                                                                  *
+ ************************************************************************************/
+
+typedef struct {
+    double scale, exponent;                 // Sequential seconds = scale decimals^exponent, 0 if not a candidate
+    int mpi;                                // It has an MPI version
+} algorithm_cost_t;
+
+static const algorithm_cost_t algorithm_costs[AUTO_NUM_ALGORITHMS] = {
+    {1.759e-09, 2.00, 1},   // 0: BBP
+    {3.359e-09, 1.90, 1},   // 1: Bellard (First version)
+    {1.571e-10, 2.47, 1},   // 2: Bellard (Last version)
+    {3.017e-12, 2.74, 1},   // 3: Chudnovsky
+    {2.897e-09, 1.41, 1},   // 4: Chudnovsky (Binary splitting)
+    {1.380e-07, 1.33, 1},   // 5: BBP (Binary splitting)
+    {1.012e-07, 1.32, 1},   // 6: Bellard (Binary splitting)
+    {0, 0, 0},              // 7: BBP hex digits, it does not compute pi
+    {1.774e-08, 1.36, 0},   // 8: Gauss Legendre
+    {5.445e-08, 1.31, 1},   // 9: Machin-like (Takano)
+    {7.264e-08, 1.27, 1},   // 10: Machin-like (Stormer)
+    {2.483e-10, 1.98, 1},   // 11: BBP (Fixed point)
+    {1.353e-10, 2.01, 1},   // 12: Bellard (Fixed point)
+};
+
+#define NUM_ALGORITHM_COSTS ((int) (sizeof(algorithm_costs) / sizeof(algorithm_cost_t)))
+
+
+/*
+ * Reads the values of a row into values from cursor, growing it as needed.
+ * Returns the number of values
+ */
+static int read_row(char * cursor, double ** values, int offset, int * capacity){
+    int count, read;
+    double value;
+
+    count = 0;
+    while (sscanf(cursor, "%lf%n", &value, &read) == 1){
+        if (offset + count >= *capacity){
+            *capacity = (*capacity > 0) ? 2 * *capacity : 1024;
+            *values = realloc(*values, *capacity * sizeof(double));
+        }
+        (*values)[offset + count] = (value > 0) ? value : 0;
+        cursor += read;
+        count++;
+    }
+    return count;
+}
+
+/*
+ * Returns 0 on success and -1 if the file can not be read or its rows differ in length
+ */
+int read_profile(const char * file_name, profile_t * profile){
+    int count, capacity, algorithm, read, seconds_capacity;
+    long step;
+    char * line;
+    size_t line_size;
+    FILE * file;
+
+    file = fopen(file_name, "r");
+    if (file == NULL) return -1;
+
+    profile -> num_workers = 0;
+    profile -> num_points = 0;
+    profile -> decimals_step = AUTO_DECIMALS_STEP;
+    profile -> ratios = NULL;
+    for(algorithm = 0; algorithm < AUTO_NUM_ALGORITHMS; algorithm++){
+        profile -> seconds[algorithm] = NULL;
+        profile -> seconds_points[algorithm] = 0;
+    }
+    capacity = 0;
+    line = NULL;
+    line_size = 0;
+    while (getline(&line, &line_size, file) != -1){
+        if (line[0] == '#'){
+            if (sscanf(line, "# step %ld", &step) == 1 && step > 0) profile -> decimals_step = step;
+            if (sscanf(line, "# seconds %d%n", &algorithm, &read) == 1 && algorithm >= 0 && algorithm < AUTO_NUM_ALGORITHMS){
+                free(profile -> seconds[algorithm]);
+                profile -> seconds[algorithm] = NULL;
+                seconds_capacity = 0;
+                profile -> seconds_points[algorithm] = read_row(line + read, &profile -> seconds[algorithm], 0, &seconds_capacity);
+            }
+            continue;
+        }
+        count = read_row(line, &profile -> ratios, profile -> num_workers * profile -> num_points, &capacity);
+        if (count == 0) continue;
+        if (profile -> num_points == 0) profile -> num_points = count;
+        if (count != profile -> num_points){
+            free(line);
+            free_profile(profile);
+            fclose(file);
+            return -1;
+        }
+        profile -> num_workers++;
+    }
+    free(line);
+    fclose(file);
+    if (profile -> num_workers == 0){
+        free_profile(profile);
+        return -1;
+    }
+    return 0;
+}
+
+void free_profile(profile_t * profile){
+    int algorithm;
+
+    free(profile -> ratios);
+    for(algorithm = 0; algorithm < AUTO_NUM_ALGORITHMS; algorithm++) free(profile -> seconds[algorithm]);
+}
+
+/*
+ * Timing ratio of num_workers workers at the column position, 0 if it was not measured
+ */
+double profile_ratio(const profile_t * profile, int num_workers, double position){
+    int column;
+    double fraction;
+    const double * row = profile -> ratios + (num_workers - 1) * profile -> num_points;
+
+    column = (int) position;
+    fraction = position - column;
+    if (fraction == 0) return row[column];
+    if (row[column] == 0 || row[column + 1] == 0) return 0;
+    return row[column] * (1 - fraction) + row[column + 1] * fraction;
+}
+
+/*
+ * Speed-up of num_workers workers over one for precision decimals, 0 if the profile
+ * has not measured it. Beyond the measured precisions the closest column is used
+ */
+double profile_speed_up(const profile_t * profile, int num_workers, int precision){
+    double position, sequential, parallel;
+
+    if (num_workers < 1 || num_workers > profile -> num_workers) return 0;
+    position = (double) precision / profile -> decimals_step - 1;
+    if (position < 0) position = 0;
+    if (position > profile -> num_points - 1) position = profile -> num_points - 1;
+
+    sequential = profile_ratio(profile, 1, position);
+    parallel = profile_ratio(profile, num_workers, position);
+    return (sequential > 0 && parallel > 0) ? sequential / parallel : 0;
+}
+
+/*
+ * Sequential seconds of the algorithm for precision decimals, from the measured row
+ * of the profile if it has one and from the fitted power of the decimals otherwise
+ */
+double sequential_seconds(const profile_t * profile, int algorithm, int precision){
+    int column, last;
+    double position, fraction, measured;
+    const double * row = profile -> seconds[algorithm];
+    const algorithm_cost_t * cost = &algorithm_costs[algorithm];
+
+    if (row != NULL && profile -> seconds_points[algorithm] > 0){
+        last = profile -> seconds_points[algorithm] - 1;
+        position = (double) precision / profile -> decimals_step - 1;
+        if (position < 0) position = 0;
+        if (position > last) position = last;
+        column = (int) position;
+        fraction = position - column;
+        measured = (fraction == 0) ? row[column] :
+                    ((row[column] > 0 && row[column + 1] > 0) ? row[column] * (1 - fraction) + row[column + 1] * fraction : 0);
+        if (measured > 0) return measured * pow(precision / ((position + 1) * profile -> decimals_step), cost -> exponent);
+    }
+    return cost -> scale * pow(precision, cost -> exponent);
+}
+
+int host_cores(){
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cores > 0) ? (int) cores : 1;
+}
+
+int auto_candidate(int algorithm, int backend){
+    if (algorithm < 0 || algorithm >= NUM_ALGORITHM_COSTS || algorithm_costs[algorithm].scale == 0) return 0;
+    return backend != AUTO_MPI || algorithm_costs[algorithm].mpi;
+}
+
+/*
+ * Chooses the algorithm and the threads of each of the num_procs processes that
+ * minimize the expected time, with at most max_threads threads per process.
+ * A non negative algorithm or a positive num_threads is kept as it is
+ */
+void auto_configure(const char * file_name, int backend, int precision, int num_procs, int max_threads,
+                        int algorithm, int num_threads, autoconfig_t * config){
+    int candidate, threads, first_threads, last_threads;
+    double speed_up, time;
+    profile_t profile;
+
+    if (read_profile(file_name, &profile) != 0){
+        printf("  The profile %s could not be read \n\n", file_name);
+        exit(-1);
+    }
+    if (algorithm >= 0 && !auto_candidate(algorithm, backend)){
+        printf("  Algorithm %d can not be auto configured in this version \n\n", algorithm);
+        exit(-1);
+    }
+
+    first_threads = (num_threads > 0) ? num_threads : 1;
+    last_threads = (num_threads > 0) ? num_threads : max_threads;
+    config -> algorithm = -1;
+    config -> num_procs = num_procs;
+    for(candidate = 0; candidate < NUM_ALGORITHM_COSTS; candidate++){
+        if (!auto_candidate(candidate, backend) || (algorithm >= 0 && candidate != algorithm)) continue;
+        for(threads = first_threads; threads <= last_threads; threads++){
+            speed_up = profile_speed_up(&profile, threads * num_procs, precision);
+            if (speed_up == 0){
+                if (threads > first_threads) continue;      // Not measured with so many workers
+                speed_up = 1;
+            }
+            time = sequential_seconds(&profile, candidate, precision) / speed_up;
+            if (config -> algorithm < 0 || time < (1 - AUTO_MIN_GAIN) * config -> expected_time){
+                config -> algorithm = candidate;
+                config -> num_threads = threads;
+                config -> speed_up = speed_up;
+                config -> expected_time = time;
+            }
+        }
+    }
+    free_profile(&profile);
+}
+
+void print_autoconfig(const char * file_name, autoconfig_t * config){
+    printf("  Auto configuration (%s): algorithm %d, %d threads, %d processes \n",
+                file_name, config -> algorithm, config -> num_threads, config -> num_procs);
+    printf("  Expected speed-up: %.2f, estimated time: %.3f seconds \n", config -> speed_up, config -> expected_time);
+}
@@ -1,36 +1,190 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <mpfr.h>
+#include "../../Headers/Common/Check_decimals.h"
+#include "../../Headers/Common/Decimal_conversion.h"
+#include "../../Headers/Common/Report.h"
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CHECK_DECIMALS_X86
+#include <immintrin.h>
+#endif
 
-int check_decimals(mpfr_t pi){
-    //Cast the number we want to check to string
-    int bytes_of_pi =  ( (int) ceil((float) pi -> _mpfr_prec / (float) GMP_NUMB_BITS) ) * sizeof(mp_limb_t);
-    char calculated_pi[bytes_of_pi * 8]; 
-    mpfr_sprintf(calculated_pi, "%Re", pi);
 
-    //Read the correct pi number from numeroPiCorrecto.txt file and compares the decimals to calculated pi
-    FILE * file;
-    file = fopen("Resources/numeroPiCorrecto.txt", "r");
-    if(file == NULL){
-        printf("numeroPiCorrecto.txt not found \n");
-        exit(-1);
-    } 
+/************************************************************************************
+ * Decimal verifier                                                                 *
+ * The reference file is mapped in memory and compared with the computed digits     *
+ * in blocks of CHECK_BLOCK_BYTES, split among the threads. Every block looks for   *
+ * its first mismatch comparing 64 bytes (AVX-512), 32 bytes (AVX2) or 8 bytes at   *
+ * a time, and the blocks after a mismatch that has already been found are skipped. *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * Position of the first different byte of a and b, or length if they are equal
+ */
+static long first_mismatch_scalar(const char * a, const char * b, long length){
+    long i;
+    uint64_t x, y;
+
+    for(i = 0; i + 8 <= length; i += 8){
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        if (x != y) break;
+    }
+    for(; i < length && a[i] == b[i]; i++);
+    return i;
+}
+
+#ifdef CHECK_DECIMALS_X86
+
+__attribute__((target("avx2")))
+static long first_mismatch_avx2(const char * a, const char * b, long length){
+    long i;
+    uint32_t equal;
+
+    for(i = 0; i + 32 <= length; i += 32){
+        equal = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (a + i)),
+                                                                  _mm256_loadu_si256((const __m256i *) (b + i))));
+        if (equal != 0xFFFFFFFFu) return i + __builtin_ctz(~equal);
+    }
+    return i + first_mismatch_scalar(a + i, b + i, length - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static long first_mismatch_avx512(const char * a, const char * b, long length){
+    long i;
+    uint64_t different;
+
+    for(i = 0; i + 64 <= length; i += 64){
+        different = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512((const void *) (a + i)),
+                                            _mm512_loadu_si512((const void *) (b + i)));
+        if (different != 0) return i + __builtin_ctzll(different);
+    }
+    return i + first_mismatch_scalar(a + i, b + i, length - i);
+}
+
+#endif
+
+/*
+ * Position of the first different byte of a and b, or length if they are equal.
+ * Uses the widest compare supported by the CPU
+ */
+static long first_mismatch(const char * a, const char * b, long length){
+#ifdef CHECK_DECIMALS_X86
+    if (__builtin_cpu_supports("avx512bw")) return first_mismatch_avx512(a, b, length);
+    if (__builtin_cpu_supports("avx2")) return first_mismatch_avx2(a, b, length);
+#endif
+    return first_mismatch_scalar(a, b, length);
+}
 
-    char correct_pi_char;
-    int i = 0;
-    while((correct_pi_char = fgetc(file)) != EOF){
-        if( (i >= (bytes_of_pi * 8)) || (correct_pi_char != calculated_pi[i])){
-            break;
+/*
+ * Position of the first different byte of a and b, or length if they are equal.
+ * The blocks are compared by num_threads threads. The first mismatch is shared, so
+ * no thread compares the blocks after a mismatch that another one has found
+ */
+long find_first_mismatch(const char * a, const char * b, long length, int num_threads){
+    long block, num_blocks, start, count, mismatch, first, known;
+
+    first = length;
+    num_blocks = (length + CHECK_BLOCK_BYTES - 1) / CHECK_BLOCK_BYTES;
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1) private(start, count, mismatch, known) \
+                shared(first)
+#else
+    (void) num_threads;
+#endif
+        for(block = 0; block < num_blocks; block++){
+            start = block * CHECK_BLOCK_BYTES;
+#ifdef _OPENMP
+            #pragma omp atomic read
+#endif
+            known = first;
+            if (start >= known) continue;           // There is a mismatch before this block
+            count = (length - start < CHECK_BLOCK_BYTES) ? length - start : CHECK_BLOCK_BYTES;
+            mismatch = first_mismatch(a + start, b + start, count);
+            if (mismatch < count){
+#ifdef _OPENMP
+                #pragma omp critical(first_mismatch)
+#endif
+                if (start + mismatch < first){
+#ifdef _OPENMP
+                    #pragma omp atomic write
+#endif
+                    first = start + mismatch;
+                }
+            }
         }
-        i++;
+
+    return first;
+}
+
+/*
+ * Maps file_name in memory (read only).
+ * Returns NULL if it can not be read
+ */
+char * map_file(const char * file_name, long * length){
+    int fd;
+    char * data;
+    struct stat file_stat;
+
+    fd = open(file_name, O_RDONLY);
+    if (fd < 0) return NULL;
+    if (fstat(fd, &file_stat) != 0){
+        close(fd);
+        return NULL;
     }
-    i = (i < 2) ? 0: i - 2;
-    
-    fclose(file);
+    * length = file_stat.st_size;
+    data = mmap(NULL, (* length > 0) ? * length : 1, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
 
-    //mpfr_printf("Pi: %Re \n", pi);
+    return (data == MAP_FAILED) ? NULL : data;
+}
 
-    return i;
-}
\ No newline at end of file
+void unmap_file(char * data, long length){
+    munmap(data, (length > 0) ? length : 1);
+}
+
+int check_decimals(mpfr_t pi, int num_threads){
+    long num_decimals, length_of_pi, length_of_reference, matches;
+    double started;
+    char * calculated_pi, * correct_pi;
+
+    started = phase_begin();
+
+    //Map the correct pi number from numeroPiCorrecto.txt file
+    correct_pi = map_file(REFERENCE_FILE, &length_of_reference);
+    if (correct_pi == NULL){
+        printf("numeroPiCorrecto.txt not found \n");
+        exit(-1);
+    }
+
+    //Cast the number we want to check to string, with the decimals its precision can hold
+    num_decimals = (long) (mpfr_get_prec(pi) * log10(2)) + 1;
+    if (num_decimals > length_of_reference) num_decimals = length_of_reference;
+    calculated_pi = malloc(decimal_buffer_size(pi, num_decimals));
+    phase_end(PHASE_VERIFICATION, 0, started);
+    started = phase_begin();
+    length_of_pi = mpfr_get_decimals(calculated_pi, pi, num_decimals, num_threads);
+    phase_end(PHASE_CONVERSION, 0, started);
+    started = phase_begin();
+
+    //Compare the decimals to calculated pi
+    matches = find_first_mismatch(correct_pi, calculated_pi,
+                                    (length_of_pi < length_of_reference) ? length_of_pi : length_of_reference, num_threads);
+    matches = (matches < 2) ? 0 : matches - 2;
+
+    unmap_file(correct_pi, length_of_reference);
+    free(calculated_pi);
+    phase_end(PHASE_VERIFICATION, 0, started);
+
+    return (int) matches;
+}
@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mpfr.h>
+#include "../../Headers/Sequential/BBP_digits.h"
+#include "../../Headers/Common/Check_hex_digits.h"
+#include "../../Headers/Common/Report.h"
+
+#define HEX_TOLERANCE 256       // The last two hex digits of BBP may be wrong by rounding
+#define HEX_BLOCKS_PER_THREAD 4 // Blocks of the range of k of an extraction per thread
+
+static int hex_verification = 0;
+
+
+/*
+ * The hex spot checks cost about as much as a fast series of the same decimals,
+ * so they are only done if they are asked for (--verify=hex)
+ */
+void set_hex_verification(int enabled){
+    hex_verification = enabled;
+}
+
+int get_hex_verification(){
+    return hex_verification;
+}
+
+
+/*
+ * Gets the BBP_HEX_DIGITS hex digits of x after position as an integer
+ */
+unsigned long mpfr_hex_digits(mpfr_t x, long position){
+    unsigned long digits;
+    long shift;
+    mpz_t mantissa;
+
+    mpz_init(mantissa);
+    shift = - mpfr_get_z_2exp(mantissa, x) - 4 * (position + BBP_HEX_DIGITS);
+    if (shift >= 0) mpz_tdiv_q_2exp(mantissa, mantissa, shift);
+    else mpz_mul_2exp(mantissa, mantissa, -shift);
+    digits = mpz_tdiv_ui(mantissa, 1UL << (4 * BBP_HEX_DIGITS));
+    mpz_clear(mantissa);
+
+    return digits;
+}
+
+/*
+ * BBP digit extraction of the BBP_HEX_DIGITS hex digits after position as an
+ * integer. The range of k is divided in blocks that the threads sum
+ */
+unsigned long BBP_hex_digits_threads(long position, int num_threads){
+    int block;
+    long num_terms;
+    long double sum;
+    char hex[BBP_HEX_DIGITS + 1];
+
+    num_terms = position + 1 + BBP_TAIL_TERMS;
+    sum = 0;
+#ifdef _OPENMP
+    #pragma omp parallel for reduction(+:sum) num_threads(num_threads) schedule(dynamic, 1)
+#endif
+        for(block = 0; block < HEX_BLOCKS_PER_THREAD * num_threads; block++){
+            sum += BBP_digits_partial(position, num_terms * block / (HEX_BLOCKS_PER_THREAD * num_threads), 
+                                        num_terms * (block + 1) / (HEX_BLOCKS_PER_THREAD * num_threads));
+        }
+    BBP_fraction_to_hex(hex, sum);
+
+    return strtoul(hex, NULL, 16);
+}
+
+/*
+ * Checks the binary expansion of pi against hex digits obtained with the BBP digit
+ * extraction at the middle and at the tail of the digits that should be correct.
+ * No reference file is needed. precision is the number of correct decimals expected.
+ * Each extraction costs O(n log n) word operations at position n, so there are only
+ * two, and each one is split among the num_threads threads.
+ * Returns the number of positions that match, out of HEX_SPOT_CHECKS
+ */
+int check_hex_digits(mpfr_t pi, int precision, int num_threads){
+    int i, matches;
+    long last_position, positions[HEX_SPOT_CHECKS];
+    unsigned long expected, computed, distance;
+    double started = phase_begin();
+
+    //Hex digits that should be correct, minus the digits of the last extraction
+    last_position = (long) (precision * log2(10) / 4) - BBP_HEX_DIGITS - 2;
+    if (last_position < 0) last_position = 0;
+    positions[0] = last_position / 2;
+    positions[1] = last_position;
+
+    matches = 0;
+    for(i = 0; i < HEX_SPOT_CHECKS; i++){
+        expected = BBP_hex_digits_threads(positions[i], num_threads);
+        computed = mpfr_hex_digits(pi, positions[i]);
+        distance = (expected - computed) & ((1UL << (4 * BBP_HEX_DIGITS)) - 1);
+        if (distance <= HEX_TOLERANCE || distance >= (1UL << (4 * BBP_HEX_DIGITS)) - HEX_TOLERANCE){
+            matches++;
+        }
+    }
+    phase_end(PHASE_VERIFICATION, 0, started);
+
+    return matches;
+}
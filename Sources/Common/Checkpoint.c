@@ -0,0 +1,416 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <mpfr.h>
+#include "../../Headers/Common/Checkpoint.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Xxhash.h"
+
+
+/************************************************************************************
+ * Checkpoint and restart of the series                                             *
+ * The iterations are split in units (a block of iterations of a thread). The       *
+ * state of a unit is its partial sum, its recurrence state and its next iteration, *
+ * so each unit can be resumed alone, whatever the threads or processes that        *
+ * resume it. The checkpoint file keeps two copies of the state of every unit:      *
+ *                                                                                  *
+ *      header | blocks of the units | unit 0: copy 0, copy 1 | unit 1: ...         *
+ *                                                                                  *
+ * Every CHECKPOINT_INTERVAL seconds a writer thread asks the units for their       *
+ * state. The workers copy it to a staging buffer at the end of their current       *
+ * iteration and go on, while the writer thread writes it over the oldest copy,     *
+ * with a sequence number and a hash. A copy that was being written when the run    *
+ * died does not match its hash, so the other one is resumed.                       *
+ *                                                                                  *
+ ************************************************************************************/
+
+static const char * checkpoint_file = NULL;
+static int resume_checkpoint = 0;
+
+
+void set_checkpoint_file(const char * file_name, int resume){
+    checkpoint_file = file_name;
+    resume_checkpoint = resume;
+}
+
+/*
+ * Checkpoint file, NULL if there is none
+ */
+const char * get_checkpoint_file(){
+    return checkpoint_file;
+}
+
+/*
+ * Bytes of a saved value: its precision, sign, exponent and limbs
+ */
+long checkpoint_value_bytes(long precision_bits){
+    long num_limbs = (precision_bits + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+    return 3 * sizeof(int64_t) + num_limbs * sizeof(mp_limb_t);
+}
+
+/*
+ * Bytes of each copy of the state of a unit: hash, sequence, next and the values
+ */
+long checkpoint_slot_bytes(int num_values, long precision_bits){
+    return 3 * sizeof(int64_t) + num_values * checkpoint_value_bytes(precision_bits);
+}
+
+long checkpoint_slot_offset(checkpoint_t * checkpoint, int unit, long sequence){
+    return checkpoint -> header_bytes + (2L * unit + sequence % 2) * checkpoint -> slot_bytes;
+}
+
+/*
+ * Header and blocks of the units as they are written in the checkpoint file
+ */
+char * checkpoint_header(checkpoint_t * checkpoint){
+    int unit;
+    char * buffer;
+    int64_t * blocks;
+    checkpoint_header_t * header;
+
+    buffer = calloc(checkpoint -> header_bytes, 1);
+    header = (checkpoint_header_t *) buffer;
+    blocks = (int64_t *) (buffer + sizeof(checkpoint_header_t));
+    memcpy(header -> magic, CHECKPOINT_MAGIC, 8);
+    header -> algorithm = checkpoint -> algorithm;
+    header -> num_values = checkpoint -> num_values;
+    header -> num_iterations = checkpoint -> num_iterations;
+    header -> precision_bits = checkpoint -> precision_bits;
+    header -> taper = get_precision_tapering();
+    header -> num_units = checkpoint -> num_units;
+    header -> slot_bytes = checkpoint -> slot_bytes;
+    for(unit = 0; unit < checkpoint -> num_units; unit++){
+        blocks[2 * unit] = checkpoint -> units[unit].start;
+        blocks[2 * unit + 1] = checkpoint -> units[unit].end;
+    }
+    header -> hash = 0;
+    header -> hash = xxhash64(buffer, checkpoint -> header_bytes, 0);
+
+    return buffer;
+}
+
+/*
+ * Reads the blocks of the units and finds the last valid copy of each state.
+ * Returns -1 if there is no checkpoint file, it exits if it belongs to other run
+ */
+int checkpoint_load(checkpoint_t * checkpoint){
+    int fd, unit, copy;
+    long length;
+    uint64_t hash;
+    char * buffer, * slot;
+    int64_t * blocks, * values;
+    checkpoint_header_t header;
+
+    fd = open(checkpoint_file, O_RDONLY);
+    if (fd < 0) return -1;
+    if (pread(fd, &header, sizeof(header), 0) != sizeof(header) || memcmp(header.magic, CHECKPOINT_MAGIC, 8) != 0
+            || header.num_units <= 0 || header.algorithm != checkpoint -> algorithm
+            || header.num_values != checkpoint -> num_values || header.num_iterations != checkpoint -> num_iterations
+            || header.precision_bits != checkpoint -> precision_bits || header.taper != get_precision_tapering()
+            || header.slot_bytes != checkpoint -> slot_bytes){
+        printf("  The checkpoint %s does not belong to this algorithm, precision and options \n\n", checkpoint_file);
+        exit(-1);
+    }
+
+    checkpoint -> num_units = header.num_units;
+    checkpoint -> header_bytes = sizeof(checkpoint_header_t) + 2 * header.num_units * sizeof(int64_t);
+    buffer = malloc(checkpoint -> header_bytes);
+    length = pread(fd, buffer, checkpoint -> header_bytes, 0);
+    hash = ((checkpoint_header_t *) buffer) -> hash;
+    ((checkpoint_header_t *) buffer) -> hash = 0;
+    if (length != checkpoint -> header_bytes || xxhash64(buffer, checkpoint -> header_bytes, 0) != hash){
+        printf("  The checkpoint %s is corrupted \n\n", checkpoint_file);
+        exit(-1);
+    }
+
+    blocks = (int64_t *) (buffer + sizeof(checkpoint_header_t));
+    checkpoint -> units = malloc(checkpoint -> num_units * sizeof(checkpoint_unit_t));
+    slot = malloc(checkpoint -> slot_bytes);
+    for(unit = 0; unit < checkpoint -> num_units; unit++){
+        checkpoint -> units[unit].start = blocks[2 * unit];
+        checkpoint -> units[unit].end = blocks[2 * unit + 1];
+        checkpoint -> units[unit].next = -1;
+        checkpoint -> units[unit].sequence = -1;
+        for(copy = 0; copy < 2; copy++){
+            values = (int64_t *) slot;
+            if (pread(fd, slot, checkpoint -> slot_bytes, checkpoint_slot_offset(checkpoint, unit, copy))
+                    != checkpoint -> slot_bytes) continue;
+            if (xxhash64(slot + sizeof(int64_t), checkpoint -> slot_bytes - sizeof(int64_t), 0) != (uint64_t) values[0]
+                    || values[1] % 2 != copy || values[1] <= checkpoint -> units[unit].sequence
+                    || values[2] < checkpoint -> units[unit].start || values[2] > checkpoint -> units[unit].end) continue;
+            checkpoint -> units[unit].sequence = values[1];
+            checkpoint -> units[unit].next = values[2];
+        }
+    }
+
+    close(fd);
+    free(slot);
+    free(buffer);
+    return 0;
+}
+
+/*
+ * Writes the header and empty states (they do not match their hashes)
+ */
+void checkpoint_create(checkpoint_t * checkpoint){
+    int fd;
+    char * buffer;
+
+    buffer = checkpoint_header(checkpoint);
+    fd = open(checkpoint_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || write(fd, buffer, checkpoint -> header_bytes) != checkpoint -> header_bytes
+            || ftruncate(fd, checkpoint_slot_offset(checkpoint, checkpoint -> num_units, 0)) != 0){
+        printf("  The checkpoint %s could not be created \n\n", checkpoint_file);
+        exit(-1);
+    }
+    close(fd);
+    free(buffer);
+}
+
+/*
+ * Splits the iterations in num_units units (the same cost for each one with tapering),
+ * or takes the units of the checkpoint file if the run is resumed.
+ * The main process creates the checkpoint file if there is one
+ */
+void checkpoint_begin(checkpoint_t * checkpoint, int algorithm, int num_iterations, int num_units, long precision_bits,
+                        double bits_per_term, int num_values, int main_process){
+    int unit, block_start, block_end;
+    long done;
+
+    checkpoint -> enabled = (checkpoint_file != NULL);
+    checkpoint -> algorithm = algorithm;
+    checkpoint -> num_values = num_values;
+    checkpoint -> num_iterations = num_iterations;
+    checkpoint -> precision_bits = precision_bits;
+    checkpoint -> slot_bytes = checkpoint_slot_bytes(num_values, precision_bits);
+
+    if (checkpoint -> enabled && resume_checkpoint && checkpoint_load(checkpoint) == 0){
+        done = 0;
+        for(unit = 0; unit < checkpoint -> num_units; unit++){
+            if (checkpoint -> units[unit].next >= 0) done += checkpoint -> units[unit].next - checkpoint -> units[unit].start;
+        }
+        if (main_process) printf("  Resumed from checkpoint: %ld of %d iterations were done \n", done, num_iterations);
+        return;
+    }
+
+    checkpoint -> num_units = num_units;
+    checkpoint -> header_bytes = sizeof(checkpoint_header_t) + 2 * num_units * sizeof(int64_t);
+    checkpoint -> units = malloc(num_units * sizeof(checkpoint_unit_t));
+    for(unit = 0; unit < num_units; unit++){
+        taper_block(0, num_iterations, num_units, unit, precision_bits, bits_per_term, &block_start, &block_end);
+        checkpoint -> units[unit].start = block_start;
+        checkpoint -> units[unit].end = block_end;
+        checkpoint -> units[unit].next = -1;
+        checkpoint -> units[unit].sequence = -1;
+    }
+    if (checkpoint -> enabled && main_process) checkpoint_create(checkpoint);
+}
+
+/*
+ * Writes the staged states and waits until all of them are on disk.
+ * Returns the number of states written. The lock is held when it is called
+ */
+int checkpoint_write_staged(checkpoint_t * checkpoint, char * slot){
+    int unit, written;
+    long sequence;
+    int64_t * values = (int64_t *) slot;
+
+    written = 0;
+    for(unit = checkpoint -> first_unit; unit < checkpoint -> last_unit; unit++){
+        if (!checkpoint -> units[unit].staged) continue;
+        memcpy(slot, checkpoint -> units[unit].staging, checkpoint -> slot_bytes);
+        checkpoint -> units[unit].staged = 0;
+        sequence = ++checkpoint -> units[unit].sequence;
+        pthread_mutex_unlock(&checkpoint -> lock);
+
+        values[1] = sequence;
+        values[0] = xxhash64(slot + sizeof(int64_t), checkpoint -> slot_bytes - sizeof(int64_t), 0);
+        if (pwrite(checkpoint -> fd, slot, checkpoint -> slot_bytes, checkpoint_slot_offset(checkpoint, unit, sequence))
+                != checkpoint -> slot_bytes){
+            printf("  The checkpoint %s could not be written \n", checkpoint_file);
+        }
+        written++;
+
+        pthread_mutex_lock(&checkpoint -> lock);
+    }
+    if (written > 0){
+        pthread_mutex_unlock(&checkpoint -> lock);
+        fdatasync(checkpoint -> fd);
+        pthread_mutex_lock(&checkpoint -> lock);
+    }
+    return written;
+}
+
+/*
+ * Writer thread: asks the units for their state every CHECKPOINT_INTERVAL seconds
+ * and writes it, until the checkpoint ends
+ */
+void * checkpoint_thread(void * arg){
+    int unit;
+    char * slot;
+    struct timespec deadline, now;
+    checkpoint_t * checkpoint = (checkpoint_t *) arg;
+
+    slot = malloc(checkpoint -> slot_bytes);
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += CHECKPOINT_INTERVAL;
+
+    pthread_mutex_lock(&checkpoint -> lock);
+    while (1){
+        if (checkpoint_write_staged(checkpoint, slot) > 0) continue;     // More states may be staged meanwhile
+        if (checkpoint -> closing) break;
+        if (pthread_cond_timedwait(&checkpoint -> wake, &checkpoint -> lock, &deadline) == ETIMEDOUT){
+            for(unit = checkpoint -> first_unit; unit < checkpoint -> last_unit; unit++){
+                __atomic_store_n(&checkpoint -> units[unit].requested, 1, __ATOMIC_RELAXED);
+            }
+            clock_gettime(CLOCK_REALTIME, &now);
+            deadline.tv_sec = now.tv_sec + CHECKPOINT_INTERVAL;
+        }
+    }
+    pthread_mutex_unlock(&checkpoint -> lock);
+
+    free(slot);
+    return NULL;
+}
+
+/*
+ * Starts the writer thread of the units [first_unit, last_unit), the ones of this process
+ */
+void checkpoint_start(checkpoint_t * checkpoint, int first_unit, int last_unit){
+    int unit;
+
+    checkpoint -> first_unit = first_unit;
+    checkpoint -> last_unit = last_unit;
+    if (!checkpoint -> enabled) return;
+
+    checkpoint -> fd = open(checkpoint_file, O_WRONLY);
+    if (checkpoint -> fd < 0){
+        printf("  The checkpoint %s could not be opened \n\n", checkpoint_file);
+        exit(-1);
+    }
+    for(unit = first_unit; unit < last_unit; unit++){
+        checkpoint -> units[unit].requested = 0;
+        checkpoint -> units[unit].staged = 0;
+        checkpoint -> units[unit].staging = calloc(checkpoint -> slot_bytes, 1);
+    }
+    checkpoint -> closing = 0;
+    pthread_mutex_init(&checkpoint -> lock, NULL);
+    pthread_cond_init(&checkpoint -> wake, NULL);
+    pthread_create(&checkpoint -> thread, NULL, checkpoint_thread, checkpoint);
+}
+
+/*
+ * Sets the NULL terminated list of variables to the saved state of the unit,
+ * with their saved precisions. Returns its next iteration, or -1 if there is no
+ * saved state and the unit has to start from the beginning of its block
+ */
+long checkpoint_restore(checkpoint_t * checkpoint, int unit, mpfr_ptr x, ...){
+    int fd;
+    long length, num_limbs;
+    char * slot, * position;
+    int64_t * values;
+    va_list args;
+
+    if (!checkpoint -> enabled || checkpoint -> units[unit].next < 0) return -1;
+
+    slot = malloc(checkpoint -> slot_bytes);
+    fd = open(checkpoint_file, O_RDONLY);
+    length = (fd < 0) ? -1 : pread(fd, slot, checkpoint -> slot_bytes,
+                                    checkpoint_slot_offset(checkpoint, unit, checkpoint -> units[unit].sequence));
+    if (fd >= 0) close(fd);
+    if (length != checkpoint -> slot_bytes){
+        printf("  The checkpoint %s could not be read \n\n", checkpoint_file);
+        exit(-1);
+    }
+
+    position = slot + 3 * sizeof(int64_t);
+    va_start(args, x);
+    while (x != NULL){
+        values = (int64_t *) position;
+        mpfr_set_prec(x, values[0]);
+        x -> _mpfr_sign = (int) values[1];
+        x -> _mpfr_exp = values[2];
+        num_limbs = (values[0] + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+        memcpy(x -> _mpfr_d, position + 3 * sizeof(int64_t), num_limbs * sizeof(mp_limb_t));
+        position += checkpoint_value_bytes(checkpoint -> precision_bits);
+        x = va_arg(args, mpfr_ptr);
+    }
+    va_end(args);
+
+    free(slot);
+    return checkpoint -> units[unit].next;
+}
+
+/*
+ * Stages the state of the unit (the NULL terminated list of its variables) if the
+ * writer thread asked for it or the unit has finished. The iterations before next
+ * are the ones added to the partial sum
+ */
+void checkpoint_save(checkpoint_t * checkpoint, int unit, long next, mpfr_ptr x, ...){
+    long num_limbs;
+    char * position;
+    int64_t * values;
+    va_list args;
+    checkpoint_unit_t * state = &checkpoint -> units[unit];
+
+    //The flag is read without the lock in every iteration, the lock orders the rest
+    if (!checkpoint -> enabled || (!__atomic_load_n(&state -> requested, __ATOMIC_RELAXED) && next < state -> end)) return;
+
+    pthread_mutex_lock(&checkpoint -> lock);
+    ((int64_t *) state -> staging)[2] = next;
+    position = state -> staging + 3 * sizeof(int64_t);
+    va_start(args, x);
+    while (x != NULL){
+        values = (int64_t *) position;
+        values[0] = mpfr_get_prec(x);
+        values[1] = x -> _mpfr_sign;
+        values[2] = x -> _mpfr_exp;
+        num_limbs = (values[0] + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+        memcpy(position + 3 * sizeof(int64_t), x -> _mpfr_d, num_limbs * sizeof(mp_limb_t));
+        position += checkpoint_value_bytes(checkpoint -> precision_bits);
+        x = va_arg(args, mpfr_ptr);
+    }
+    va_end(args);
+    __atomic_store_n(&state -> requested, 0, __ATOMIC_RELAXED);
+    state -> staged = 1;
+    pthread_cond_signal(&checkpoint -> wake);
+    pthread_mutex_unlock(&checkpoint -> lock);
+}
+
+/*
+ * Writes the last staged states and stops the writer thread.
+ * The checkpoint file is kept until checkpoint_remove
+ */
+void checkpoint_end(checkpoint_t * checkpoint){
+    int unit;
+
+    if (checkpoint -> enabled){
+        pthread_mutex_lock(&checkpoint -> lock);
+        checkpoint -> closing = 1;
+        pthread_cond_signal(&checkpoint -> wake);
+        pthread_mutex_unlock(&checkpoint -> lock);
+        pthread_join(checkpoint -> thread, NULL);
+
+        close(checkpoint -> fd);
+        for(unit = checkpoint -> first_unit; unit < checkpoint -> last_unit; unit++){
+            free(checkpoint -> units[unit].staging);
+        }
+        pthread_mutex_destroy(&checkpoint -> lock);
+        pthread_cond_destroy(&checkpoint -> wake);
+    }
+    free(checkpoint -> units);
+}
+
+/*
+ * Deletes the checkpoint file once the result is complete
+ */
+void checkpoint_remove(checkpoint_t * checkpoint){
+    if (checkpoint -> enabled) unlink(checkpoint_file);
+}
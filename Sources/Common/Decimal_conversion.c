@@ -0,0 +1,291 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include "../../Headers/Common/Decimal_conversion.h"
+
+
+/************************************************************************************
+ * Divide and conquer binary to decimal conversion                                  *
+ * The decimals of x are the digits of the integer z = floor(|x| 10^d), which is    *
+ * split recursively by the powers 10^(B 2^k):                                      *
+ *                                                                                  *
+ *      z = q 10^(B 2^k) + r   ->   digits(z) = digits(q) . digits(r)               *
+ *                                                                                  *
+ * where r is written with exactly B 2^k digits (zero padded). Both halves are      *
+ * independent, so q is converted by an omp task while r is converted by the        *
+ * current thread. The powers are computed once, squaring 10^B.                     *
+ * The streamed conversion splits z in the same way down to pieces of a chunk, and  *
+ * converts one piece per thread at a time                                          *
+ *                                                                                  *
+ ************************************************************************************/
+
+typedef struct {
+    mpz_t z;
+    long length;                            // Digits of the piece, zero padded
+    int level;                              // Largest power that may split it
+} conversion_piece_t;
+
+
+/*
+ * Computes the powers 10^(B 2^k) with less digits than length.
+ * Returns the number of powers
+ */
+int init_powers(mpz_t * powers, long length){
+    int num_levels;
+
+    num_levels = 0;
+    while (num_levels < CONVERSION_MAX_LEVELS && ((long) CONVERSION_BASE_DIGITS << num_levels) < length){
+        mpz_init(powers[num_levels]);
+        if (num_levels == 0) mpz_ui_pow_ui(powers[0], 10, CONVERSION_BASE_DIGITS);
+        else mpz_mul(powers[num_levels], powers[num_levels - 1], powers[num_levels - 1]);
+        num_levels++;
+    }
+    return num_levels;
+}
+
+/*
+ * Writes the length digits of z to buffer, zero padded on the left.
+ * z must be lower than 10^length and powers[k] is 10^(CONVERSION_BASE_DIGITS 2^k)
+ */
+void digits_to_buffer(char * buffer, mpz_t z, long length, mpz_t * powers, int level){
+    long split, written;
+    char piece[CONVERSION_BASE_DIGITS + 3];
+    mpz_t q, r;
+
+    //Largest power with less digits than the piece
+    while (level >= 0 && ((long) CONVERSION_BASE_DIGITS << level) >= length) level--;
+
+    if (level < 0){
+        mpz_get_str(piece, 10, z);
+        written = (mpz_sgn(z) == 0) ? 0 : strlen(piece);
+        memset(buffer, '0', length - written);
+        memcpy(buffer + length - written, piece, written);
+        return;
+    }
+
+    split = (long) CONVERSION_BASE_DIGITS << level;
+    mpz_inits(q, r, NULL);
+    mpz_tdiv_qr(q, r, z, powers[level]);
+
+#ifdef _OPENMP
+    #pragma omp task if(length > CONVERSION_MIN_TASK_DIGITS) shared(q, powers)
+#endif
+    digits_to_buffer(buffer, q, length - split, powers, level);
+
+    digits_to_buffer(buffer + length - split, r, split, powers, level - 1);
+#ifdef _OPENMP
+    #pragma omp taskwait
+#endif
+
+    mpz_clears(q, r, NULL);
+}
+
+/*
+ * Size of the buffer needed to write x with num_decimals decimals
+ */
+long decimal_buffer_size(mpfr_t x, long num_decimals){
+    long integer_digits;
+
+    integer_digits = 1;
+    if (mpfr_regular_p(x) && mpfr_get_exp(x) > 0){
+        integer_digits = (long) (mpfr_get_exp(x) * log10(2)) + 2;
+    }
+    return num_decimals + integer_digits + 3;   // Sign, decimal point and null char
+}
+
+/*
+ * Writes the length digits of z to buffer, zero padded on the left, splitting
+ * the conversion among num_threads threads (omp tasks).
+ * z must be lower than 10^length
+ */
+void mpz_get_decimals(char * buffer, mpz_t z, long length, int num_threads){
+    int num_levels;
+    mpz_t powers[CONVERSION_MAX_LEVELS];
+
+    num_levels = init_powers(powers, length);
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(num_threads)
+    #pragma omp single
+#else
+    (void) num_threads;
+#endif
+    digits_to_buffer(buffer, z, length, powers, num_levels - 1);
+
+    //Clear memory
+    while (num_levels > 0) mpz_clear(powers[--num_levels]);
+}
+
+/*
+ * Number of pieces of at most chunk_digits digits that split_pieces makes of
+ * length digits
+ */
+long count_pieces(long length, int level, long chunk_digits){
+    long split;
+
+    while (level >= 0 && ((long) CONVERSION_BASE_DIGITS << level) >= length) level--;
+    if (level < 0 || length <= chunk_digits) return 1;
+
+    split = (long) CONVERSION_BASE_DIGITS << level;
+    return count_pieces(length - split, level, chunk_digits) + count_pieces(split, level - 1, chunk_digits);
+}
+
+/*
+ * Splits z in pieces of at most chunk_digits digits, from the most significant one,
+ * with both halves of every split as omp tasks. If owned, z is cleared as soon as
+ * it is split, so the pieces take about as much memory as z
+ */
+void split_pieces(mpz_t z, int owned, long length, mpz_t * powers, int level, long chunk_digits,
+                    conversion_piece_t * pieces){
+    long split, first;
+    mpz_t q, r;
+
+    while (level >= 0 && ((long) CONVERSION_BASE_DIGITS << level) >= length) level--;
+
+    if (level < 0 || length <= chunk_digits){
+        mpz_init(pieces[0].z);
+        if (owned) mpz_swap(pieces[0].z, z);
+        else mpz_set(pieces[0].z, z);
+        pieces[0].length = length;
+        pieces[0].level = level;
+        return;
+    }
+
+    split = (long) CONVERSION_BASE_DIGITS << level;
+    first = count_pieces(length - split, level, chunk_digits);
+    mpz_inits(q, r, NULL);
+    mpz_tdiv_qr(q, r, z, powers[level]);
+    if (owned) mpz_clear(z);
+
+#ifdef _OPENMP
+    #pragma omp task if(length > CONVERSION_MIN_TASK_DIGITS) shared(q, powers, pieces)
+#endif
+    split_pieces(q, 1, length - split, powers, level, chunk_digits, pieces);
+
+    split_pieces(r, 1, split, powers, level - 1, chunk_digits, pieces + first);
+#ifdef _OPENMP
+    #pragma omp taskwait
+#endif
+
+    mpz_clears(q, r, NULL);
+    if (owned) mpz_init(z);                     // The caller clears it
+}
+
+/*
+ * Converts the length digits of z (zero padded) in chunks of at most chunk_digits
+ * digits, from the most significant one, and passes them to sink in order.
+ * z is split in pieces by all the threads, then the threads convert a piece each
+ * at a time and the converted ones are passed to sink while the next ones wait,
+ * so the memory is that of z plus num_threads chunks.
+ * z must be lower than 10^length
+ */
+void mpz_stream_decimals(mpz_t z, long length, long chunk_digits, int num_threads, 
+                            decimals_sink_t sink, void * data){
+    int num_levels;
+    long num_pieces, first, last, piece;
+    char * chunks;
+    conversion_piece_t * pieces;
+    mpz_t powers[CONVERSION_MAX_LEVELS];
+
+    if (chunk_digits < CONVERSION_BASE_DIGITS) chunk_digits = CONVERSION_BASE_DIGITS;
+    if (num_threads < 1) num_threads = 1;
+    num_levels = init_powers(powers, length);
+    num_pieces = count_pieces(length, num_levels - 1, chunk_digits);
+    pieces = malloc(num_pieces * sizeof(conversion_piece_t));
+    chunks = malloc(num_threads * chunk_digits);
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(num_threads)
+    #pragma omp single
+#endif
+    split_pieces(z, 0, length, powers, num_levels - 1, chunk_digits, pieces);
+
+    for(first = 0; first < num_pieces; first += num_threads){
+        last = (first + num_threads < num_pieces) ? first + num_threads : num_pieces;
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1)
+#endif
+            for(piece = first; piece < last; piece++){
+                digits_to_buffer(chunks + (piece - first) * chunk_digits, pieces[piece].z, pieces[piece].length, 
+                                    powers, pieces[piece].level);
+                mpz_clear(pieces[piece].z);
+            }
+        for(piece = first; piece < last; piece++){
+            sink(chunks + (piece - first) * chunk_digits, pieces[piece].length, data);
+        }
+    }
+
+    //Clear memory
+    while (num_levels > 0) mpz_clear(powers[--num_levels]);
+    free(pieces);
+    free(chunks);
+}
+
+/*
+ * Sets z = floor(|x| 10^num_decimals), computed exactly from the significand of x.
+ * Returns the number of digits of the integer part of x (at least one)
+ */
+long mpfr_get_scaled_decimals(mpz_t z, mpfr_t x, long num_decimals, int * negative){
+    long integer_digits;
+    mpfr_exp_t exponent;
+    mpz_t aux;
+
+    mpz_init(aux);
+    exponent = mpfr_get_z_2exp(z, x);
+    * negative = mpz_sgn(z) < 0;
+    mpz_abs(z, z);
+
+    //Digits of the integer part, mpz_sizeinbase may be one too big
+    if (exponent < 0) mpz_tdiv_q_2exp(aux, z, -exponent);
+    else mpz_mul_2exp(aux, z, exponent);
+    integer_digits = mpz_sizeinbase(aux, 10);
+    if (integer_digits > 1){
+        mpz_t power;
+        mpz_init(power);
+        mpz_ui_pow_ui(power, 10, integer_digits - 1);
+        if (mpz_cmp(aux, power) < 0) integer_digits--;
+        mpz_clear(power);
+    }
+
+    mpz_ui_pow_ui(aux, 10, num_decimals);
+    mpz_mul(z, z, aux);
+    if (exponent < 0) mpz_tdiv_q_2exp(z, z, -exponent);
+    else mpz_mul_2exp(z, z, exponent);
+    mpz_clear(aux);
+
+    return integer_digits;
+}
+
+/*
+ * Writes x truncated to num_decimals decimals to buffer (sign, integer part,
+ * decimal point and decimals). buffer must have at least decimal_buffer_size chars.
+ * The conversion is split among num_threads threads (omp tasks).
+ * Returns the number of chars written, without the null char
+ */
+long mpfr_get_decimals(char * buffer, mpfr_t x, long num_decimals, int num_threads){
+    int negative;
+    long integer_digits, position;
+    mpz_t z;
+
+    if (!mpfr_number_p(x)) return mpfr_sprintf(buffer, "%Rf", x);
+
+    mpz_init(z);
+    integer_digits = mpfr_get_scaled_decimals(z, x, num_decimals, &negative);
+
+    //The digits are written one char to the right and the integer part moved to its place
+    position = 0;
+    if (negative) buffer[position++] = '-';
+    mpz_get_decimals(buffer + position + 1, z, integer_digits + num_decimals, num_threads);
+    memmove(buffer + position, buffer + position + 1, integer_digits);
+    buffer[position + integer_digits] = '.';
+    position += integer_digits + num_decimals + 1;
+    buffer[position] = '\0';
+
+    //Clear memory
+    mpz_clear(z);
+
+    return position;
+}
@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../../Headers/Common/Division_kernel.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define DIVISION_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+#define DIVISION_MAGIC 0x4330000000000000ULL    // Bits of the double 2^52
+
+
+/************************************************************************************
+ * Batched division by small divisors                                               *
+ * Several long divisions by divisors lower than 2^31 advance together, one         *
+ * 32 bit quotient digit per step, over a numerator whose digits are all zero       *
+ * (the leading digits are divided by the caller). Each lane keeps a remainder:     *
+ *                                                                                  *
+ *      q = rem 2^32 / divisor,        rem = rem 2^32 - q divisor                   *
+ *                                                                                  *
+ * The quotient is estimated multiplying by the reciprocal of the divisor in        *
+ * double precision, which is off by one at most, and corrected with the exact      *
+ * remainder. The signed quotients of all the lanes are added in a single           *
+ * 64 bit digit, so the caller only propagates the carries once                     *
+ *                                                                                  *
+ ************************************************************************************/
+
+static int division_kernel_selected = DIVISION_KERNEL_MPN;
+
+static const char * division_kernel_names[] = {"auto", "mpn", "scalar", "avx2", "avx512"};
+
+
+/*
+ * Returns 1 if the kernel can run in this CPU
+ */
+int division_kernel_supported(int kernel){
+    switch (kernel)
+    {
+    case DIVISION_KERNEL_AUTO:
+    case DIVISION_KERNEL_MPN:
+    case DIVISION_KERNEL_SCALAR:
+        return 1;
+#ifdef DIVISION_KERNEL_X86
+    case DIVISION_KERNEL_AVX2:
+        return __builtin_cpu_supports("avx2");
+    case DIVISION_KERNEL_AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return 0;
+    }
+}
+
+/*
+ * Selects the kernel used by division_kernel.
+ * The automatic selection picks the widest SIMD kernel supported by the CPU.
+ * Returns -1 if the kernel is not supported
+ */
+int set_division_kernel(int kernel){
+    if (!division_kernel_supported(kernel)) return -1;
+    if (kernel == DIVISION_KERNEL_AUTO){
+        if (division_kernel_supported(DIVISION_KERNEL_AVX512)) kernel = DIVISION_KERNEL_AVX512;
+        else if (division_kernel_supported(DIVISION_KERNEL_AVX2)) kernel = DIVISION_KERNEL_AVX2;
+        else kernel = DIVISION_KERNEL_SCALAR;
+    }
+    division_kernel_selected = kernel;
+    return 0;
+}
+
+int get_division_kernel(){
+    return division_kernel_selected;
+}
+
+/*
+ * Returns the kernel with that name or -1 if there is none
+ */
+int division_kernel_from_name(const char * name){
+    int kernel;
+
+    for(kernel = DIVISION_KERNEL_AUTO; kernel <= DIVISION_KERNEL_AVX512; kernel++){
+        if (strcmp(name, division_kernel_names[kernel]) == 0) return kernel;
+    }
+    return -1;
+}
+
+const char * division_kernel_name(int kernel){
+    return division_kernel_names[kernel];
+}
+
+/*
+ * Adds a lane to the batch
+ */
+void division_lane(division_lanes_t * lanes, uint64_t rem, uint64_t divisor, int negative){
+    int lane = lanes -> num_lanes++;
+
+    lanes -> rem[lane] = rem;
+    lanes -> divisor[lane] = divisor;
+    lanes -> inverse[lane] = 4294967296.0 / divisor;
+    lanes -> negative[lane] = negative ? -1 : 0;
+}
+
+/*
+ * Scalar kernel, one lane after the other
+ */
+static void division_kernel_scalar(int64_t * digits, long num_digits, division_lanes_t * lanes){
+    int j;
+    long k;
+    uint64_t q, rem, divisor;
+    int64_t r, digit;
+
+    for(k = num_digits - 1; k >= 0; k--){
+        digit = 0;
+        for(j = 0; j < lanes -> num_lanes; j++){
+            rem = lanes -> rem[j];
+            divisor = lanes -> divisor[j];
+            q = (uint64_t) ((double) rem * lanes -> inverse[j]);
+            r = (int64_t) ((rem << DIVISION_DIGIT_BITS) - q * divisor);
+            if (r < 0){
+                q--;
+                r += divisor;
+            } else if (r >= (int64_t) divisor){
+                q++;
+                r -= divisor;
+            }
+            lanes -> rem[j] = r;
+            digit += (q ^ lanes -> negative[j]) - lanes -> negative[j];
+        }
+        digits[k] = digit;
+    }
+}
+
+#ifdef DIVISION_KERNEL_X86
+
+/*
+ * AVX2 kernel, groups of 4 lanes
+ */
+__attribute__((target("avx2")))
+static void division_kernel_avx2(int64_t * digits, long num_digits, division_lanes_t * lanes){
+    int g, num_groups;
+    long k;
+    __m256i rem[DIVISION_MAX_LANES / 4], divisor[DIVISION_MAX_LANES / 4], negative[DIVISION_MAX_LANES / 4];
+    __m256d inverse[DIVISION_MAX_LANES / 4];
+    __m256i magic, zero, q, r, mask, sum;
+    __m128i half;
+
+    num_groups = (lanes -> num_lanes + 3) / 4;
+    for(g = 0; g < num_groups; g++){
+        rem[g] = _mm256_loadu_si256((__m256i *) &lanes -> rem[4 * g]);
+        divisor[g] = _mm256_loadu_si256((__m256i *) &lanes -> divisor[4 * g]);
+        negative[g] = _mm256_loadu_si256((__m256i *) &lanes -> negative[4 * g]);
+        inverse[g] = _mm256_loadu_pd(&lanes -> inverse[4 * g]);
+    }
+    magic = _mm256_set1_epi64x(DIVISION_MAGIC);
+    zero = _mm256_setzero_si256();
+
+    for(k = num_digits - 1; k >= 0; k--){
+        sum = zero;
+        for(g = 0; g < num_groups; g++){
+            //q = rem / divisor (rounded), converted through the 2^52 magic number
+            q = _mm256_castpd_si256(_mm256_add_pd(_mm256_mul_pd(
+                    _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(rem[g], magic)), _mm256_castsi256_pd(magic)),
+                    inverse[g]), _mm256_castsi256_pd(magic)));
+            q = _mm256_sub_epi64(q, magic);
+            r = _mm256_sub_epi64(_mm256_slli_epi64(rem[g], DIVISION_DIGIT_BITS), _mm256_mul_epu32(q, divisor[g]));
+
+            //Correct the estimation
+            mask = _mm256_cmpgt_epi64(zero, r);
+            q = _mm256_add_epi64(q, mask);
+            r = _mm256_add_epi64(r, _mm256_and_si256(mask, divisor[g]));
+            mask = _mm256_cmpgt_epi64(r, _mm256_sub_epi64(divisor[g], _mm256_set1_epi64x(1)));
+            q = _mm256_sub_epi64(q, mask);
+            r = _mm256_sub_epi64(r, _mm256_and_si256(mask, divisor[g]));
+            rem[g] = r;
+
+            sum = _mm256_add_epi64(sum, _mm256_sub_epi64(_mm256_xor_si256(q, negative[g]), negative[g]));
+        }
+        half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        digits[k] = _mm_cvtsi128_si64(half) + _mm_extract_epi64(half, 1);
+    }
+
+    for(g = 0; g < num_groups; g++){
+        _mm256_storeu_si256((__m256i *) &lanes -> rem[4 * g], rem[g]);
+    }
+}
+
+/*
+ * AVX-512 kernel, groups of 8 lanes
+ */
+__attribute__((target("avx512f")))
+static void division_kernel_avx512(int64_t * digits, long num_digits, division_lanes_t * lanes){
+    int g, num_groups;
+    long k;
+    __m512i rem[DIVISION_MAX_LANES / 8], divisor[DIVISION_MAX_LANES / 8];
+    __m512d inverse[DIVISION_MAX_LANES / 8];
+    __mmask8 negative[DIVISION_MAX_LANES / 8], mask;
+    __m512i magic, zero, one, q, r, sum;
+
+    num_groups = (lanes -> num_lanes + 7) / 8;
+    for(g = 0; g < num_groups; g++){
+        rem[g] = _mm512_loadu_si512(&lanes -> rem[8 * g]);
+        divisor[g] = _mm512_loadu_si512(&lanes -> divisor[8 * g]);
+        negative[g] = _mm512_cmpneq_epi64_mask(_mm512_loadu_si512(&lanes -> negative[8 * g]), _mm512_setzero_si512());
+        inverse[g] = _mm512_loadu_pd(&lanes -> inverse[8 * g]);
+    }
+    magic = _mm512_set1_epi64(DIVISION_MAGIC);
+    zero = _mm512_setzero_si512();
+    one = _mm512_set1_epi64(1);
+
+    for(k = num_digits - 1; k >= 0; k--){
+        sum = zero;
+        for(g = 0; g < num_groups; g++){
+            //q = rem / divisor (rounded), converted through the 2^52 magic number
+            q = _mm512_castpd_si512(_mm512_add_pd(_mm512_mul_pd(
+                    _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(rem[g], magic)), _mm512_castsi512_pd(magic)),
+                    inverse[g]), _mm512_castsi512_pd(magic)));
+            q = _mm512_sub_epi64(q, magic);
+            r = _mm512_sub_epi64(_mm512_slli_epi64(rem[g], DIVISION_DIGIT_BITS), _mm512_mul_epu32(q, divisor[g]));
+
+            //Correct the estimation
+            mask = _mm512_cmplt_epi64_mask(r, zero);
+            q = _mm512_mask_sub_epi64(q, mask, q, one);
+            r = _mm512_mask_add_epi64(r, mask, r, divisor[g]);
+            mask = _mm512_cmpge_epi64_mask(r, divisor[g]);
+            q = _mm512_mask_add_epi64(q, mask, q, one);
+            r = _mm512_mask_sub_epi64(r, mask, r, divisor[g]);
+            rem[g] = r;
+
+            sum = _mm512_add_epi64(sum, _mm512_mask_sub_epi64(q, negative[g], zero, q));
+        }
+        digits[k] = _mm512_reduce_add_epi64(sum);
+    }
+
+    for(g = 0; g < num_groups; g++){
+        _mm512_storeu_si512(&lanes -> rem[8 * g], rem[g]);
+    }
+}
+
+#endif
+
+/*
+ * Computes the num_digits next quotient digits of all the lanes, from the
+ * most significant one (digits[num_digits - 1]) to the least significant one.
+ * digits[k] is the sum of the quotient digits of the lanes, with their signs
+ */
+void division_kernel(int64_t * digits, long num_digits, division_lanes_t * lanes){
+    int j;
+
+    //Unused lanes divide 0 by 1, so they add nothing
+    for(j = lanes -> num_lanes; j < DIVISION_MAX_LANES; j++){
+        lanes -> rem[j] = 0;
+        lanes -> divisor[j] = 1;
+        lanes -> inverse[j] = 0.0;
+        lanes -> negative[j] = 0;
+    }
+
+    switch (division_kernel_selected)
+    {
+#ifdef DIVISION_KERNEL_X86
+    case DIVISION_KERNEL_AVX2:
+        division_kernel_avx2(digits, num_digits, lanes);
+        break;
+    case DIVISION_KERNEL_AVX512:
+        division_kernel_avx512(digits, num_digits, lanes);
+        break;
+#endif
+    default:
+        division_kernel_scalar(digits, num_digits, lanes);
+        break;
+    }
+}
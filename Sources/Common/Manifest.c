@@ -0,0 +1,320 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include "../../Headers/Common/Manifest.h"
+#include "../../Headers/Common/Xxhash.h"
+#include "../../Headers/Common/Decimal_conversion.h"
+#include "../../Headers/Common/Check_decimals.h"
+#include "../../Headers/Common/Report.h"
+
+
+/************************************************************************************
+ * Reference manifests                                                              *
+ * Instead of the reference decimals, a manifest keeps the xxHash64 of every chunk  *
+ * of chunk_digits decimals (the integer part and the decimal point are not         *
+ * hashed), so it needs 17 bytes per chunk:                                         *
+ *                                                                                  *
+ *      PIMANIFEST chunk_digits num_decimals                                        *
+ *      hash of the decimals [0, chunk_digits)                                      *
+ *      hash of the decimals [chunk_digits, 2 chunk_digits)                         *
+ *      ...                                                                         *
+ *                                                                                  *
+ * The computed decimals are checked while they are converted: every batch of       *
+ * chunks is hashed by the threads and compared with the manifest. The first bad    *
+ * chunk is narrowed down to its first wrong decimal if the reference decimals      *
+ * file covers it. The decimals after the last whole chunk of a run can only be     *
+ * checked with the reference decimals file, so a longer run needs a whole chunk    *
+ *                                                                                  *
+ ************************************************************************************/
+
+typedef struct {
+    const manifest_t * manifest;
+    char * batch;                           // Chunks waiting to be hashed
+    int batch_chunks, num_threads;
+    int filled;                             // Full chunks of the batch
+    long fill;                              // Digits of the chunk being filled
+    long first_chunk;                       // Manifest chunk of the first one of the batch
+    long skip;                              // Integer digits that are not hashed
+    long bad_chunk, bad_decimal;            // -1 while they are not found
+} manifest_check_t;
+
+static const char * manifest_file = NULL;
+
+
+void set_manifest_file(const char * file_name){
+    manifest_file = file_name;
+}
+
+/*
+ * Manifest used to check the decimals, NULL if there is none
+ */
+const char * get_manifest_file(){
+    return manifest_file;
+}
+
+/*
+ * Hashes the chunks of num_decimals decimals using num_threads threads
+ */
+void hash_chunks(const char * decimals, long num_decimals, long chunk_digits, uint64_t * hashes, int num_threads){
+    long chunk, num_chunks, count;
+
+    num_chunks = (num_decimals + chunk_digits - 1) / chunk_digits;
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1) private(count)
+#else
+    (void) num_threads;
+#endif
+        for(chunk = 0; chunk < num_chunks; chunk++){
+            count = num_decimals - chunk * chunk_digits;
+            if (count > chunk_digits) count = chunk_digits;
+            hashes[chunk] = xxhash64(decimals + chunk * chunk_digits, count, MANIFEST_HASH_SEED);
+        }
+}
+
+/*
+ * Returns 0 on success and -1 if the file can not be written
+ */
+int write_manifest(const char * file_name, const manifest_t * manifest){
+    long chunk;
+    FILE * file;
+
+    file = fopen(file_name, "w");
+    if (file == NULL) return -1;
+    fprintf(file, "%s %ld %ld\n", MANIFEST_MAGIC, manifest -> chunk_digits, manifest -> num_decimals);
+    for(chunk = 0; chunk < manifest -> num_chunks; chunk++){
+        fprintf(file, "%016llx\n", (unsigned long long) manifest -> hashes[chunk]);
+    }
+    return (fclose(file) == 0) ? 0 : -1;
+}
+
+/*
+ * Returns 0 on success and -1 if the file can not be read or is not a manifest
+ */
+int read_manifest(const char * file_name, manifest_t * manifest){
+    long chunk;
+    unsigned long long hash;
+    char magic[16];
+    FILE * file;
+
+    file = fopen(file_name, "r");
+    if (file == NULL) return -1;
+    if (fscanf(file, "%15s %ld %ld", magic, &manifest -> chunk_digits, &manifest -> num_decimals) != 3
+            || strcmp(magic, MANIFEST_MAGIC) != 0 || manifest -> chunk_digits <= 0 || manifest -> num_decimals < 0){
+        fclose(file);
+        return -1;
+    }
+
+    manifest -> num_chunks = (manifest -> num_decimals + manifest -> chunk_digits - 1) / manifest -> chunk_digits;
+    manifest -> hashes = malloc((manifest -> num_chunks + 1) * sizeof(uint64_t));
+    for(chunk = 0; chunk < manifest -> num_chunks; chunk++){
+        if (fscanf(file, "%llx", &hash) != 1){
+            free(manifest -> hashes);
+            fclose(file);
+            return -1;
+        }
+        manifest -> hashes[chunk] = hash;
+    }
+    fclose(file);
+    return 0;
+}
+
+void free_manifest(manifest_t * manifest){
+    free(manifest -> hashes);
+}
+
+/*
+ * Returns 0 if the manifest can check a run of precision decimals and -1 otherwise:
+ * the decimals of a run longer than the reference decimals file have to fill a
+ * whole chunk or reach the end of the manifest
+ */
+int check_manifest_length(const char * file_name, long precision){
+    manifest_t manifest;
+
+    if (read_manifest(file_name, &manifest) != 0){
+        printf("  The manifest %s could not be read \n\n", file_name);
+        return -1;
+    }
+    if (precision > REFERENCE_DECIMALS && precision < manifest.chunk_digits && precision < manifest.num_decimals){
+        printf("  The run is shorter than one manifest chunk (%ld decimals), so %s can not check it. \n",
+                    manifest.chunk_digits, file_name);
+        printf("  Try with a manifest of smaller chunks or without --manifest. \n\n");
+        free_manifest(&manifest);
+        return -1;
+    }
+    free_manifest(&manifest);
+    return 0;
+}
+
+/*
+ * Compares count decimals of the batch, from its chunk position, with the reference
+ * decimals file from the decimal start. Returns the decimals that match, -1 if the
+ * reference does not cover them
+ */
+long match_reference(manifest_check_t * check, int position, long start, long count){
+    long length_of_reference, matches;
+    char * correct_pi;
+
+    correct_pi = map_file(REFERENCE_FILE, &length_of_reference);
+    if (correct_pi == NULL) return -1;
+
+    matches = -1;
+    if (start + count + 2 <= length_of_reference){      // The reference starts with "3."
+        matches = find_first_mismatch(correct_pi + 2 + start, check -> batch + position * check -> manifest -> chunk_digits,
+                                        count, check -> num_threads);
+    }
+    unmap_file(correct_pi, length_of_reference);
+    return matches;
+}
+
+/*
+ * Finds the first wrong decimal of the chunk of the batch that did not match,
+ * if the reference decimals file covers it
+ */
+void narrow_bad_chunk(manifest_check_t * check, int position, long count){
+    long start, mismatch;
+
+    start = check -> bad_chunk * check -> manifest -> chunk_digits;
+    mismatch = match_reference(check, position, start, count);
+    if (mismatch >= 0 && mismatch < count) check -> bad_decimal = start + mismatch;
+}
+
+/*
+ * Hashes the chunks of the batch (the last one may be partial) and compares them
+ * with the manifest
+ */
+void check_batch(manifest_check_t * check){
+    int i, num_chunks;
+    long count, chunk_digits, bad;
+    double started;
+
+    started = phase_begin();
+    chunk_digits = check -> manifest -> chunk_digits;
+    num_chunks = check -> filled + (check -> fill > 0);
+    bad = LONG_MAX;
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(check -> num_threads) private(count) reduction(min:bad)
+#endif
+        for(i = 0; i < num_chunks; i++){
+            count = (i < check -> filled) ? chunk_digits : check -> fill;
+            if (xxhash64(check -> batch + i * chunk_digits, count, MANIFEST_HASH_SEED)
+                    != check -> manifest -> hashes[check -> first_chunk + i]){
+                if (check -> first_chunk + i < bad) bad = check -> first_chunk + i;
+            }
+        }
+
+    if (bad != LONG_MAX){
+        check -> bad_chunk = bad;
+        i = (int) (bad - check -> first_chunk);
+        narrow_bad_chunk(check, i, (i < check -> filled) ? chunk_digits : check -> fill);
+    }
+    check -> first_chunk += num_chunks;
+    check -> filled = 0;
+    check -> fill = 0;
+    phase_end(PHASE_VERIFICATION, 0, started);
+}
+
+/*
+ * Sink of the decimal conversion: copies the decimals to the chunks of the batch
+ */
+void check_digits(const char * digits, long length, void * data){
+    long count, chunk_digits;
+    manifest_check_t * check = (manifest_check_t *) data;
+
+    chunk_digits = check -> manifest -> chunk_digits;
+    count = (check -> skip < length) ? check -> skip : length;
+    check -> skip -= count;
+    digits += count;
+    length -= count;
+
+    while (length > 0 && check -> bad_chunk < 0){
+        count = chunk_digits - check -> fill;
+        if (count > length) count = length;
+        memcpy(check -> batch + check -> filled * chunk_digits + check -> fill, digits, count);
+        check -> fill += count;
+        digits += count;
+        length -= count;
+        if (check -> fill == chunk_digits){
+            check -> filled++;
+            check -> fill = 0;
+            if (check -> filled == check -> batch_chunks) check_batch(check);
+        }
+    }
+}
+
+/*
+ * Checks the first precision decimals of pi with the manifest, as many as it covers:
+ * whole chunks unless the manifest ends before, and the decimals after the last
+ * whole chunk with the reference decimals file. Returns the number of decimals
+ * that match
+ */
+long check_manifest(const char * file_name, mpfr_t pi, long precision, int num_threads){
+    int negative, tail_position;
+    long num_decimals, whole_decimals, chunks_checked, tail, tail_matches, unchecked;
+    double started, checked;
+    manifest_t manifest;
+    manifest_check_t check;
+    mpz_t z;
+
+    if (check_manifest_length(file_name, precision) != 0 || read_manifest(file_name, &manifest) != 0) exit(-1);
+
+    num_decimals = (precision < manifest.num_decimals) ? precision : manifest.num_decimals;
+    whole_decimals = num_decimals;
+    if (num_decimals < manifest.num_decimals) whole_decimals -= num_decimals % manifest.chunk_digits;
+    if (num_decimals > REFERENCE_DECIMALS) num_decimals = whole_decimals;
+    tail = num_decimals - whole_decimals;               // Decimals checked with the reference
+    unchecked = ((precision < manifest.num_decimals) ? precision : manifest.num_decimals) - num_decimals;
+
+    check.manifest = &manifest;
+    check.num_threads = (num_threads > 0) ? num_threads : 1;
+    check.batch_chunks = check.num_threads;
+    check.batch = malloc(check.batch_chunks * manifest.chunk_digits);
+    check.filled = 0;
+    check.fill = 0;
+    check.first_chunk = 0;
+    check.bad_chunk = -1;
+    check.bad_decimal = -1;
+
+    //The batches are hashed while the decimals are converted, the rest is the conversion
+    started = phase_begin();
+    checked = phase_seconds(PHASE_VERIFICATION, 0);
+    mpz_init(z);
+    check.skip = mpfr_get_scaled_decimals(z, pi, num_decimals, &negative);
+    mpz_stream_decimals(z, check.skip + num_decimals, MANIFEST_STREAM_DIGITS, num_threads, check_digits, &check);
+    phase_add(PHASE_CONVERSION, 0, phase_begin() - started - (phase_seconds(PHASE_VERIFICATION, 0) - checked));
+    tail_position = check.filled;
+    if (tail > 0) check.fill = 0;
+    if (check.bad_chunk < 0 && (check.filled > 0 || check.fill > 0)) check_batch(&check);
+
+    chunks_checked = (check.bad_chunk < 0) ? check.first_chunk : check.bad_chunk;
+    printf("  Manifest chunks verified: %ld of %ld \n", chunks_checked, manifest.num_chunks);
+    if (check.bad_chunk < 0 && tail > 0){
+        started = phase_begin();
+        tail_matches = match_reference(&check, tail_position, whole_decimals, tail);
+        phase_end(PHASE_VERIFICATION, 0, started);
+        if (tail_matches < 0){
+            printf("  %s not found \n\n", REFERENCE_FILE);
+            exit(-1);
+        }
+        printf("  Decimals after the last whole chunk verified with %s: %ld of %ld \n", REFERENCE_FILE, tail_matches, tail);
+        num_decimals = whole_decimals + tail_matches;
+    }
+    if (check.bad_chunk < 0 && unchecked > 0){
+        printf("  Decimals after the last whole chunk not checked: %ld \n", unchecked);
+    }
+    if (check.bad_chunk >= 0){
+        printf("  First bad chunk: %ld (decimals %ld to %ld) \n", check.bad_chunk,
+                    check.bad_chunk * manifest.chunk_digits + 1, (check.bad_chunk + 1) * manifest.chunk_digits);
+        num_decimals = (check.bad_decimal >= 0) ? check.bad_decimal : check.bad_chunk * manifest.chunk_digits;
+    }
+
+    //Clear memory
+    mpz_clear(z);
+    free(check.batch);
+    free_manifest(&manifest);
+
+    return num_decimals;
+}
@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../Headers/Common/Options.h"
+#include "../../Headers/Common/Division_kernel.h"
+#include "../../Headers/Common/Checkpoint.h"
+#include "../../Headers/Common/Autoconfig.h"
+#include "../../Headers/Common/Report.h"
+
+
+/*
+ * Parses the optional params that follow the positional ones.
+ * The options of the auto configuration are only valid if argv[1] is auto.
+ * Returns 0 if all of them are correct and -1 otherwise
+ */
+int parse_options(int argc, char ** argv, int first_option, options_t * options){
+    int i;
+    char * auto_option = NULL;
+
+    options -> taper = 0;
+    options -> kernel = DIVISION_KERNEL_AUTO;
+    options -> output = NULL;
+    options -> manifest = NULL;
+    options -> checkpoint = NULL;
+    options -> resume = 0;
+    options -> profile = AUTO_PROFILE_FILE;
+    options -> algorithm = -1;
+    options -> threads = 0;
+    options -> report = REPORT_TEXT;
+    options -> verify_hex = 0;
+
+    for(i = first_option; i < argc; i++){
+        if (strcmp(argv[i], "--taper") == 0){
+            options -> taper = 1;
+        } else if (strncmp(argv[i], "--kernel=", 9) == 0){
+            options -> kernel = division_kernel_from_name(argv[i] + 9);
+            if (options -> kernel < 0){
+                printf("  Unknown division kernel: %s \n", argv[i] + 9);
+                return -1;
+            }
+            if (!division_kernel_supported(options -> kernel)){
+                printf("  Division kernel not supported by this CPU: %s \n", argv[i] + 9);
+                return -1;
+            }
+        } else if (strncmp(argv[i], "--output=", 9) == 0 && argv[i][9] != '\0'){
+            options -> output = argv[i] + 9;
+        } else if (strncmp(argv[i], "--manifest=", 11) == 0 && argv[i][11] != '\0'){
+            options -> manifest = argv[i] + 11;
+        } else if (strncmp(argv[i], "--checkpoint=", 13) == 0 && argv[i][13] != '\0'){
+            options -> checkpoint = argv[i] + 13;
+        } else if (strcmp(argv[i], "--resume") == 0){
+            options -> resume = 1;
+        } else if (strncmp(argv[i], "--profile=", 10) == 0 && argv[i][10] != '\0'){
+            options -> profile = argv[i] + 10;
+            auto_option = argv[i];
+        } else if (strncmp(argv[i], "--algorithm=", 12) == 0 && argv[i][12] != '\0'){
+            options -> algorithm = atoi(argv[i] + 12);
+            auto_option = argv[i];
+        } else if (strncmp(argv[i], "--threads=", 10) == 0 && atoi(argv[i] + 10) > 0){
+            options -> threads = atoi(argv[i] + 10);
+            auto_option = argv[i];
+        } else if (strncmp(argv[i], "--report=", 9) == 0){
+            options -> report = report_format_from_name(argv[i] + 9);
+            if (options -> report < 0){
+                printf("  Unknown report format: %s \n", argv[i] + 9);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--verify=hex") == 0){
+            options -> verify_hex = 1;
+        } else {
+            printf("  Unknown option: %s \n", argv[i]);
+            return -1;
+        }
+    }
+    if (options -> resume && options -> checkpoint == NULL){
+        printf("  --resume needs the checkpoint file: --checkpoint=FILE \n");
+        return -1;
+    }
+    if (auto_option != NULL && strcmp(argv[1], "auto") != 0){
+        printf("  %s is only used by the auto configuration: %s auto precision [options] \n", auto_option, argv[0]);
+        return -1;
+    }
+    return 0;
+}
+
+void print_options_usage(){
+    printf("  Options: \n");
+    printf("    --taper            Each term is computed only with the precision it contributes \n");
+    printf("    --kernel=NAME      Division kernel of the fixed point algorithms: \n");
+    printf("                       auto (default), mpn, scalar, avx2 or avx512 \n");
+    printf("    --output=FILE      Write the decimals to FILE \n");
+    printf("    --manifest=FILE    Check the decimals with the chunk hashes of FILE \n");
+    printf("    --checkpoint=FILE  Save the state of the series to FILE every %d seconds \n", CHECKPOINT_INTERVAL);
+    printf("                       (BBP and Chudnovsky) \n");
+    printf("    --resume           Continue from the checkpoint file \n");
+    printf("    --profile=FILE     Timing ratios of the auto configuration (default %s) \n", AUTO_PROFILE_FILE);
+    printf("    --algorithm=N      Algorithm used by the auto configuration instead of the best one \n");
+    printf("    --threads=N        Threads used by the auto configuration instead of the best ones \n");
+    printf("    --report=FORMAT    Times of the phases per thread and process: text (default) or json \n");
+    printf("                       (json writes only the report to the standard output) \n");
+    printf("    --verify=hex       Check hex digits of the runs longer than the reference decimals \n");
+    printf("                       with the BBP digit extraction (it may double the run time) \n");
+}
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include "../../Headers/Common/Output.h"
+#include "../../Headers/Common/Decimal_conversion.h"
+#include "../../Headers/Common/Writer.h"
+
+typedef struct {
+    writer_t writer;
+    long digits;                            // Digits written
+    long integer_digits;                    // The decimal point goes after them
+} output_stream_t;
+
+static const char * output_file = NULL;
+
+
+void set_output_file(const char * file_name){
+    output_file = file_name;
+}
+
+/*
+ * File where the decimals are written, NULL if they are not written
+ */
+const char * get_output_file(){
+    return output_file;
+}
+
+/*
+ * Sink of the decimal conversion: writes the digits and the decimal point
+ */
+void write_digits(const char * digits, long length, void * data){
+    long before_point;
+    output_stream_t * stream = (output_stream_t *) data;
+
+    before_point = stream -> integer_digits - stream -> digits;
+    if (before_point >= 0 && before_point < length){
+        writer_write(&stream -> writer, digits, before_point);
+        writer_write(&stream -> writer, ".", 1);
+        writer_write(&stream -> writer, digits + before_point, length - before_point);
+    } else {
+        writer_write(&stream -> writer, digits, length);
+    }
+    stream -> digits += length;
+}
+
+/*
+ * Writes pi with num_decimals decimals to file_name.
+ * The digits are converted in chunks by num_threads threads and every chunk
+ * is written by the writer thread while the next one is converted
+ */
+void write_decimals(const char * file_name, mpfr_t pi, long num_decimals, int num_threads){
+    int negative;
+    mpz_t z;
+    output_stream_t stream;
+
+    if (writer_open(&stream.writer, file_name) != 0){
+        printf("  The decimals could not be written to %s \n\n", file_name);
+        exit(-1);
+    }
+
+    mpz_init(z);
+    stream.digits = 0;
+    stream.integer_digits = mpfr_get_scaled_decimals(z, pi, num_decimals, &negative);
+    if (negative) writer_write(&stream.writer, "-", 1);
+    mpz_stream_decimals(z, stream.integer_digits + num_decimals, WRITER_CHUNK_BYTES, num_threads, 
+                            write_digits, &stream);
+    if (num_decimals == 0) writer_write(&stream.writer, ".", 1);
+
+    if (writer_close(&stream.writer) != 0){
+        printf("  The decimals could not be written to %s \n\n", file_name);
+        exit(-1);
+    }
+
+    //Clear memory
+    mpz_clear(z);
+}
@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../Headers/Common/Planner.h"
+
+
+/************************************************************************************
+ * Precision and iteration planner                                                  *
+ * Given the decimals wanted, it derives the terms of each algorithm from its       *
+ * convergence rate and the guard bits from a bound of its rounding errors          *
+ *                                                                                  *
+ ************************************************************************************
+ * Target bits:         T = (decimals + 1) log2(10)                                 *
+ *                                                                                  *
+ * Series terms:        N = T / (bits per term) + 1                                 *
+ *    After N terms the tail is lower than the first omitted term                   *
+ *                                                                                  *
+ * AGM iterations:      k such that   pi 2^(k+1) log2(e) - (k + 4) - 4 >= T         *
+ *    The error after k iterations is below pi^2 2^(k+4) e^(-pi 2^(k+1))            *
+ *                                                                                  *
+ * Guard bits:          G = log2(roundings per term N + final roundings) + safety   *
+ *    Every rounding adds at most one ulp of the working precision, and all the     *
+ *    terms are lower than pi, so the error is below 2^G ulps                       *
+ *                                                                                  *
+ ************************************************************************************/
+
+typedef struct {
+    double bits_per_term;                   // 0 if the algorithm does not plan its terms here
+    double roundings_per_term;
+    int quadratic;                          // AGM: the correct bits double every iteration
+} convergence_t;
+
+static const convergence_t convergences[] = {
+    {4.0, 12, 0},       // 0: BBP
+    {10.0, 24, 0},      // 1: Bellard (First version)
+    {10.0, 24, 0},      // 2: Bellard (Last version)
+    {47.11, 16, 0},     // 3: Chudnovsky
+    {47.11, 0, 0},      // 4: Chudnovsky (Binary splitting), exact integers
+    {4.0, 0, 0},        // 5: BBP (Binary splitting)
+    {10.0, 0, 0},       // 6: Bellard (Binary splitting)
+    {0, 0, 0},          // 7: BBP hex digits, nothing to plan
+    {0, 8, 1},          // 8: Gauss Legendre
+    {0, 0, 0},          // 9: Machin-like, every arctangent plans its terms
+    {0, 0, 0},          // 10: Machin-like
+    {4.0, 4, 0},        // 11: BBP (Fixed point), one truncation per component
+    {10.0, 7, 0},       // 12: Bellard (Fixed point)
+};
+
+#define NUM_CONVERGENCES ((int) (sizeof(convergences) / sizeof(convergence_t)))
+
+
+/*
+ * Plans the iterations and the working precision of the algorithm
+ * for precision correct decimals
+ */
+void plan_algorithm(int algorithm, int precision, plan_t * plan){
+    long target_bits;
+    double roundings;
+    const convergence_t * convergence;
+    static const convergence_t unknown = {0, 0, 0};
+
+    convergence = (algorithm >= 0 && algorithm < NUM_CONVERGENCES) ? &convergences[algorithm] : &unknown;
+    target_bits = (long) ceil((precision + 1) * BITS_PER_DECIMAL);
+
+    if (convergence -> quadratic){
+        plan -> num_iterations = 1;
+        while (M_PI * pow(2, plan -> num_iterations + 1) * M_LOG2E - (plan -> num_iterations + 4) - 4 < target_bits){
+            plan -> num_iterations++;
+        }
+    } else if (convergence -> bits_per_term > 0){
+        plan -> num_iterations = (int) ceil(target_bits / convergence -> bits_per_term) + 1;
+    } else {
+        plan -> num_iterations = 0;
+    }
+
+    roundings = convergence -> roundings_per_term * plan -> num_iterations + PLAN_FINAL_ROUNDINGS;
+    plan -> guard_bits = (long) ceil(log2(roundings)) + PLAN_SAFETY_BITS;
+    plan -> precision_bits = target_bits + plan -> guard_bits;
+    plan -> planned_decimals = precision;
+}
+
+void print_plan(plan_t * plan){
+    printf("  Planned decimals: %d (%ld bits, %ld guard bits) \n",
+                plan -> planned_decimals, plan -> precision_bits, plan -> guard_bits);
+}
+
+void print_certified_decimals(plan_t * plan, int decimals_computed){
+    printf("  Certified decimals: %d (planned %d)%s \n", decimals_computed, plan -> planned_decimals,
+                (decimals_computed < plan -> planned_decimals) ? ", the plan was not met" : "");
+}
@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <mpfr.h>
+#include "../../Headers/Common/Precision.h"
+
+
+/************************************************************************************
+ * Per-term working precision (tapering)                                            *
+ *                                                                                  *
+ * If the terms of a series decrease c bits each, the term n is scaled by 2^-cn,    *
+ * so only precision_bits - cn bits of it can affect the result. With tapering      *
+ * the quotients and products of the term n are computed with that precision        *
+ * (plus some guard bits) instead of the full one.                                  *
+ *                                                                                  *
+ ************************************************************************************/
+
+static int precision_tapering = 0;
+static double cost_exponent = 1;            // A term costs cost_overhead + working_precision^cost_exponent
+static double cost_overhead = 0;
+
+
+void set_precision_tapering(int enabled){
+    precision_tapering = enabled;
+}
+
+int get_precision_tapering(){
+    return precision_tapering;
+}
+
+void set_cost_model(double exponent, double overhead){
+    cost_exponent = exponent;
+    cost_overhead = overhead;
+}
+
+void get_cost_model(double * exponent, double * overhead){
+    * exponent = cost_exponent;
+    * overhead = cost_overhead;
+}
+
+/*
+ * Seconds per term of the probe with working_precision bits. The number of terms 
+ * grows until the probe lasts COST_PROBE_SECONDS, so the clock resolution does not matter
+ */
+double probe_term_seconds(term_probe_t probe, long working_precision){
+    int num_terms;
+    double elapsed;
+    struct timespec start, end;
+
+    for(num_terms = 1; ; num_terms *= 4){
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        probe(working_precision, num_terms);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1.e9;
+        if (elapsed >= COST_PROBE_SECONDS || num_terms >= COST_PROBE_MAX_TERMS) break;
+    }
+    return elapsed / num_terms;
+}
+
+/*
+ * Fits the cost model of the terms of a series to a short probe run of its iteration 
+ * at the full precision, a quarter and a sixteenth of it:
+ *      t(w) = c + k w^exponent,    overhead = c / k
+ * The exponent comes from the two largest precisions once the constant part is 
+ * taken away. Without tapering all the terms cost the same, so it is not needed
+ */
+void calibrate_cost_model(term_probe_t probe, long precision_bits){
+    int round;
+    long high, middle, low;
+    double t_high, t_middle, t_low, exponent, scale, constant;
+
+    if (!precision_tapering) return;
+    high = precision_bits;
+    middle = precision_bits / 4;
+    low = precision_bits / 16;
+    if (low < TAPER_MIN_PRECISION) return;          // Too small to tell the costs apart
+
+    t_high = probe_term_seconds(probe, high);
+    t_middle = probe_term_seconds(probe, middle);
+    t_low = probe_term_seconds(probe, low);
+
+    constant = 0;
+    exponent = 1;
+    for(round = 0; round < 2; round++){
+        if (t_middle > constant && t_high > t_middle) exponent = log((t_high - constant) / (t_middle - constant)) / log(4);
+        if (exponent < COST_MIN_EXPONENT) exponent = COST_MIN_EXPONENT;
+        if (exponent > COST_MAX_EXPONENT) exponent = COST_MAX_EXPONENT;
+        scale = (t_high - constant) / pow(high, exponent);
+        constant = t_low - scale * pow(low, exponent);
+        if (constant < 0) constant = 0;
+    }
+    scale = (t_high - constant) / pow(high, exponent);
+    if (scale <= 0) return;
+    set_cost_model(exponent, constant / scale);
+
+    printf("  Cost model: %.3g + %.3g w^%.2f seconds per term of w bits \n", constant, scale, exponent);
+}
+
+/*
+ * Working precision for the term n of a series whose terms decrease bits_per_term bits.
+ * It is rounded up to whole limbs, so it only changes once every few terms.
+ * Without tapering it is always precision_bits
+ */
+long term_precision(long precision_bits, long n, double bits_per_term){
+    long precision;
+
+    if (!precision_tapering) return precision_bits;
+
+    precision = precision_bits - (long) (bits_per_term * n) + TAPER_GUARD_BITS;
+    if (precision < TAPER_MIN_PRECISION) precision = TAPER_MIN_PRECISION;
+    precision = ((precision + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS) * GMP_NUMB_BITS;
+    if (precision > precision_bits) precision = precision_bits;
+    return precision;
+}
+
+/*
+ * Sets the precision of a NULL terminated list of variables.
+ * Their values are lost, so it is used for the temporaries of each term
+ */
+void set_term_precision(long precision, mpfr_ptr x, ...){
+    va_list args;
+
+    va_start(args, x);
+    while (x != NULL){
+        if (mpfr_get_prec(x) != precision) mpfr_set_prec(x, precision);
+        x = va_arg(args, mpfr_ptr);
+    }
+    va_end(args);
+}
+
+/*
+ * Rounds a NULL terminated list of variables to the precision.
+ * It is used for the dependencies that are carried from term to term
+ */
+void round_term_precision(long precision, mpfr_ptr x, ...){
+    va_list args;
+
+    va_start(args, x);
+    while (x != NULL){
+        if (mpfr_get_prec(x) != precision) mpfr_prec_round(x, precision, MPFR_RNDN);
+        x = va_arg(args, mpfr_ptr);
+    }
+    va_end(args);
+}
+
+/*
+ * Cost of the terms [0, x) with tapering. A term costs overhead + working_precision^exponent
+ * (without the rounding to limbs), so the precision decreases linearly in 
+ * [full_end, min_end) and its integral has a closed form
+ */
+double taper_cost(double x, long precision_bits, double bits_per_term){
+    double full_end, min_end, top, cost;
+
+    full_end = TAPER_GUARD_BITS / bits_per_term;                                        
+    min_end = (precision_bits + TAPER_GUARD_BITS - TAPER_MIN_PRECISION) / bits_per_term;
+    if (min_end < full_end) min_end = full_end;
+    top = precision_bits + TAPER_GUARD_BITS;
+
+    cost = cost_overhead * x;
+    if (x <= full_end) return cost + pow(precision_bits, cost_exponent) * x;
+    cost += pow(precision_bits, cost_exponent) * full_end;
+    if (x > min_end){
+        cost += pow(TAPER_MIN_PRECISION, cost_exponent) * (x - min_end);
+        x = min_end;
+    }
+    return cost + (pow(top - bits_per_term * full_end, cost_exponent + 1) - pow(top - bits_per_term * x, cost_exponent + 1)) 
+                    / (bits_per_term * (cost_exponent + 1));
+}
+
+/*
+ * First term of the block that ends a fraction of the cost of [range_start, range_end)
+ */
+int taper_boundary(int range_start, int range_end, double fraction, 
+                    long precision_bits, double bits_per_term){
+    int low, high, middle;
+    double start_cost, target;
+
+    start_cost = taper_cost(range_start, precision_bits, bits_per_term);
+    target = start_cost + fraction * (taper_cost(range_end, precision_bits, bits_per_term) - start_cost);
+    low = range_start;
+    high = range_end;
+    while (low < high){
+        middle = low + (high - low) / 2;
+        if (taper_cost(middle, precision_bits, bits_per_term) < target) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+/*
+ * Block of the terms [range_start, range_end) for block_id when they are divided in num_blocks
+ * terms that cost the same: the blocks have the same number of them (give or take one), so
+ * none is empty if there are as many terms as blocks. The binary splitting terms are exact,
+ * so they are always divided in this way.
+ */
+void even_block(int range_start, int range_end, int num_blocks, int block_id, int * block_start, int * block_end){
+    * block_start = range_start + (long) (range_end - range_start) * block_id / num_blocks;
+    * block_end = range_start + (long) (range_end - range_start) * (block_id + 1) / num_blocks;
+}
+
+/*
+ * Block of the terms [range_start, range_end) for block_id when they are divided in num_blocks.
+ * Without tapering all the terms cost the same (even_block). With tapering the blocks have 
+ * the same cost according to the cost model, so the first ones are shorter.
+ */
+void taper_block(int range_start, int range_end, int num_blocks, int block_id, 
+                    long precision_bits, double bits_per_term, int * block_start, int * block_end){
+    if (!precision_tapering){
+        even_block(range_start, range_end, num_blocks, block_id, block_start, block_end);
+    } else {
+        * block_start = (block_id == 0) ? range_start : 
+                taper_boundary(range_start, range_end, (double) block_id / num_blocks, precision_bits, bits_per_term);
+        * block_end = (block_id == num_blocks - 1) ? range_end : 
+                taper_boundary(range_start, range_end, (double) (block_id + 1) / num_blocks, precision_bits, bits_per_term);
+    }
+    if (* block_start > range_end) * block_start = range_end;
+    if (* block_end > range_end) * block_end = range_end;
+}
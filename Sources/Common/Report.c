@@ -0,0 +1,266 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../../Headers/Common/Report.h"
+
+
+/************************************************************************************
+ * Phase timers and run report                                                      *
+ * Every thread adds the monotonic time it spends in each phase of the run to its   *
+ * own timer, so they need no locks. The report gathers the timers of all the       *
+ * threads of all the processes, as [process][phase][thread], and gives for each    *
+ * phase the slowest process and the min, max and imbalance (max / mean - 1) of     *
+ * the threads and of the processes (the time of a process is its slowest thread).  *
+ * Only the threads that took part in a phase count, even if they had no work.      *
+ * The JSON report is the only output of the standard output: the rest of the       *
+ * output goes to the standard error, so a job scheduler can read it as it is.      *
+ *                                                                                  *
+ ************************************************************************************/
+
+typedef struct {
+    double min, max, mean;
+    int count;
+} phase_stats_t;
+
+static const char * phase_names[NUM_PHASES] = {"seeding", "series", "thread_reduction", "mpi_reduction",
+                                                "final_operations", "conversion", "verification", "output"};
+static const char * report_format_names[] = {"text", "json"};
+
+static int report_format = REPORT_TEXT;
+static FILE * report_stream = NULL;                 // Standard output of the JSON report
+static int phase_threads = 1;
+static int stolen_chunks = -1;                      // -1 if the run has no work stealing
+static double phase_timers[NUM_PHASES][PHASE_MAX_THREADS];
+static int phase_calls[NUM_PHASES][PHASE_MAX_THREADS];
+
+
+/*
+ * With the JSON format, the standard output is kept for the report and the rest
+ * of the output is sent to the standard error
+ */
+void set_report_format(int format){
+    report_format = format;
+    if (format == REPORT_JSON && report_stream == NULL){
+        fflush(stdout);
+        report_stream = fdopen(dup(STDOUT_FILENO), "w");
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+    }
+}
+
+int get_report_format(){
+    return report_format;
+}
+
+/*
+ * Returns -1 if the name is not a report format
+ */
+int report_format_from_name(const char * name){
+    int format;
+
+    for(format = REPORT_TEXT; format <= REPORT_JSON; format++){
+        if (strcmp(name, report_format_names[format]) == 0) return format;
+    }
+    return -1;
+}
+
+/*
+ * Clears the timers of a run with num_threads threads per process
+ */
+void reset_phases(int num_threads){
+    memset(phase_timers, 0, sizeof(phase_timers));
+    memset(phase_calls, 0, sizeof(phase_calls));
+    stolen_chunks = -1;
+    phase_threads = (num_threads < 1) ? 1 : (num_threads > PHASE_MAX_THREADS) ? PHASE_MAX_THREADS : num_threads;
+}
+
+double phase_begin(){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1.e9;
+}
+
+void phase_end(int phase, int thread_id, double started){
+    phase_add(phase, thread_id, phase_begin() - started);
+}
+
+/*
+ * Adds seconds to the timer of the thread. Adding 0 marks that the thread takes part
+ */
+void phase_add(int phase, int thread_id, double seconds){
+    if (thread_id < 0 || thread_id >= phase_threads) return;
+    phase_timers[phase][thread_id] += seconds;
+    phase_calls[phase][thread_id]++;
+}
+
+double phase_seconds(int phase, int thread_id){
+    return (thread_id >= 0 && thread_id < phase_threads) ? phase_timers[phase][thread_id] : 0;
+}
+
+/*
+ * Adds to the timer of thread 0 the part of seconds of wall time that the busiest
+ * thread has not spent in timed_phase. It is for the task trees, whose leaves are
+ * timed by the thread that runs them and whose merges are interleaved with them
+ */
+void phase_add_rest(int phase, int timed_phase, double seconds){
+    int thread;
+    double busiest = 0;
+
+    for(thread = 0; thread < phase_threads; thread++){
+        if (phase_timers[timed_phase][thread] > busiest) busiest = phase_timers[timed_phase][thread];
+    }
+    phase_add(phase, 0, (seconds > busiest) ? seconds - busiest : 0);
+}
+
+/*
+ * Adds the chunks that the threads of this process have stolen from others
+ */
+void add_stolen_chunks(int chunks){
+    stolen_chunks = (stolen_chunks < 0) ? chunks : stolen_chunks + chunks;
+}
+
+/*
+ * Returns 1 if some thread of this process has taken part in the phase
+ */
+int phase_recorded(int phase){
+    int thread;
+
+    for(thread = 0; thread < phase_threads; thread++){
+        if (phase_calls[phase][thread] > 0) return 1;
+    }
+    return 0;
+}
+
+/*
+ * Copies the timers of this process as [phase][thread] for num_threads threads,
+ * the threads without their own timer have not taken part
+ */
+void get_phase_times(int num_threads, double * seconds, int * calls){
+    int phase, thread;
+
+    for(phase = 0; phase < NUM_PHASES; phase++){
+        for(thread = 0; thread < num_threads; thread++){
+            seconds[phase * num_threads + thread] = (thread < phase_threads) ? phase_timers[phase][thread] : 0;
+            calls[phase * num_threads + thread] = (thread < phase_threads) ? phase_calls[phase][thread] : 0;
+        }
+    }
+}
+
+void add_stats(phase_stats_t * stats, double seconds){
+    if (stats -> count == 0 || seconds < stats -> min) stats -> min = seconds;
+    if (stats -> count == 0 || seconds > stats -> max) stats -> max = seconds;
+    stats -> mean = (stats -> mean * stats -> count + seconds) / (stats -> count + 1);
+    stats -> count++;
+}
+
+double imbalance(const phase_stats_t * stats){
+    return (stats -> mean > 0) ? 100 * (stats -> max / stats -> mean - 1) : 0;
+}
+
+/*
+ * Statistics of the phase over the threads and over the processes
+ */
+void phase_stats(const run_report_t * run, const double * seconds, const int * calls, int phase,
+                    phase_stats_t * threads, phase_stats_t * procs){
+    int proc, thread, offset, took_part;
+    double slowest;
+
+    memset(threads, 0, sizeof(phase_stats_t));
+    memset(procs, 0, sizeof(phase_stats_t));
+    for(proc = 0; proc < run -> num_procs; proc++){
+        took_part = 0;
+        slowest = 0;
+        for(thread = 0; thread < run -> num_threads; thread++){
+            offset = (proc * NUM_PHASES + phase) * run -> num_threads + thread;
+            if (calls[offset] == 0) continue;
+            add_stats(threads, seconds[offset]);
+            if (seconds[offset] > slowest) slowest = seconds[offset];
+            took_part = 1;
+        }
+        if (took_part) add_stats(procs, slowest);
+    }
+}
+
+void print_text_report(const run_report_t * run, const double * seconds, const int * calls){
+    int phase;
+    phase_stats_t threads, procs;
+
+    printf("  Phase times: \n");
+    for(phase = 0; phase < NUM_PHASES; phase++){
+        phase_stats(run, seconds, calls, phase, &threads, &procs);
+        if (procs.count == 0) continue;
+        printf("    %-18s %10.6f seconds", phase_names[phase], procs.max);
+        if (threads.count > procs.count){
+            printf("  threads %.6f - %.6f (imbalance %.1f%%)", threads.min, threads.max, imbalance(&threads));
+        }
+        if (procs.count > 1){
+            printf("  processes %.6f - %.6f (imbalance %.1f%%)", procs.min, procs.max, imbalance(&procs));
+        }
+        printf(" \n");
+    }
+    if (stolen_chunks >= 0) printf("    %-18s %10d \n", "chunks stolen", stolen_chunks);
+}
+
+/*
+ * One line JSON object with the configuration of the run and its phases
+ */
+void print_json_report(const run_report_t * run, const double * seconds, const int * calls){
+    int phase, proc, thread, offset, first;
+    phase_stats_t threads, procs;
+    FILE * stream = (report_stream != NULL) ? report_stream : stdout;
+
+    fprintf(stream, "{\"version\": \"%s\", \"algorithm\": %d, \"precision\": %d, \"precision_bits\": %ld, \"iterations\": %d, "
+                "\"threads\": %d, \"procs\": %d, \"taper\": %d, \"execution_seconds\": %.6f, \"decimals\": %d, ",
+                run -> version, run -> algorithm, run -> precision, run -> precision_bits, run -> num_iterations,
+                run -> num_threads, run -> num_procs, run -> taper, run -> execution_time, run -> decimals_computed);
+    if (stolen_chunks >= 0) fprintf(stream, "\"chunks_stolen\": %d, ", stolen_chunks);
+    else fprintf(stream, "\"chunks_stolen\": null, ");
+    fprintf(stream, "\"phases\": {");
+    first = 1;
+    for(phase = 0; phase < NUM_PHASES; phase++){
+        phase_stats(run, seconds, calls, phase, &threads, &procs);
+        if (procs.count == 0) continue;
+        fprintf(stream, "%s\"%s\": {\"seconds\": %.6f, \"threads\": [", (first) ? "" : ", ", phase_names[phase], procs.max);
+        for(proc = 0; proc < run -> num_procs; proc++){
+            fprintf(stream, "%s[", (proc == 0) ? "" : ", ");
+            for(thread = 0; thread < run -> num_threads; thread++){
+                offset = (proc * NUM_PHASES + phase) * run -> num_threads + thread;
+                if (calls[offset] == 0) fprintf(stream, "%snull", (thread == 0) ? "" : ", ");
+                else fprintf(stream, "%s%.6f", (thread == 0) ? "" : ", ", seconds[offset]);
+            }
+            fprintf(stream, "]");
+        }
+        fprintf(stream, "], \"thread_min\": %.6f, \"thread_max\": %.6f, \"thread_imbalance\": %.2f, "
+                    "\"proc_min\": %.6f, \"proc_max\": %.6f, \"proc_imbalance\": %.2f}",
+                    threads.min, threads.max, imbalance(&threads), procs.min, procs.max, imbalance(&procs));
+        first = 0;
+    }
+    fprintf(stream, "}}\n");
+    fflush(stream);
+}
+
+/*
+ * Prints the phases of the timers of all the processes, [process][phase][thread],
+ * in the report format
+ */
+void print_report(const run_report_t * run, const double * seconds, const int * calls){
+    if (report_format == REPORT_JSON) print_json_report(run, seconds, calls);
+    else print_text_report(run, seconds, calls);
+}
+
+/*
+ * Prints the phases of a run with a single process
+ */
+void print_process_report(const run_report_t * run){
+    double * seconds;
+    int * calls;
+
+    seconds = malloc(NUM_PHASES * run -> num_threads * sizeof(double));
+    calls = malloc(NUM_PHASES * run -> num_threads * sizeof(int));
+    get_phase_times(run -> num_threads, seconds, calls);
+    print_report(run, seconds, calls);
+    free(seconds);
+    free(calls);
+}
@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "../../Headers/Common/Scheduler.h"
+#include "../../Headers/Common/Report.h"
+
+
+/************************************************************************************
+ * Work stealing scheduler                                                          *
+ * The iterations are split in chunks and every thread starts with a contiguous     *
+ * range of them, so it carries its recurrence state from one chunk to the next     *
+ * one. A thread that runs out of chunks steals the last half of the chunks left    *
+ * by the busiest thread, and only then it has to seed the recurrences again at the *
+ * start of the stolen chunk:                                                       *
+ *                                                                                  *
+ *      thread 0:  [c0 c1 c2 c3]            thread 0:  [c0 c1]  done                *
+ *      thread 1:  [c4 c5 c6 c7]     ->     thread 1:  [c4 c5 c6]                   *
+ *                                          thread 0 steals [c7]                    *
+ *                                                                                  *
+ * The chunks stolen are added to the report of the run.                            *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * Number of chunks of num_iterations iterations for num_threads threads
+ */
+int schedule_chunks(int num_iterations, int num_threads){
+    long num_chunks = (long) num_threads * SCHEDULE_CHUNKS_PER_THREAD;
+    return (num_chunks < num_iterations) ? (int) num_chunks : num_iterations;
+}
+
+/*
+ * Every thread starts with a contiguous range of the chunks [0, num_chunks)
+ */
+void schedule_init(schedule_t * schedule, int num_chunks, int num_threads){
+    int thread;
+
+    schedule -> num_threads = num_threads;
+    schedule -> threads = malloc(num_threads * sizeof(schedule_thread_t));
+    for(thread = 0; thread < num_threads; thread++){
+        schedule -> threads[thread].next = (long) num_chunks * thread / num_threads;
+        schedule -> threads[thread].end = (long) num_chunks * (thread + 1) / num_threads;
+        schedule -> threads[thread].stolen = 0;
+    }
+    pthread_mutex_init(&schedule -> lock, NULL);
+}
+
+/*
+ * Next chunk of the thread: the next one of its range or, if it is empty, the first
+ * one of the half it steals from the thread with more chunks left.
+ * Returns -1 when all the chunks have been taken
+ */
+int schedule_next(schedule_t * schedule, int thread_id){
+    int thread, victim, left, half, chunk;
+    schedule_thread_t * own = &schedule -> threads[thread_id];
+
+    pthread_mutex_lock(&schedule -> lock);
+    if (own -> next == own -> end){
+        victim = -1;
+        left = 0;
+        for(thread = 0; thread < schedule -> num_threads; thread++){
+            if (schedule -> threads[thread].end - schedule -> threads[thread].next > left){
+                victim = thread;
+                left = schedule -> threads[thread].end - schedule -> threads[thread].next;
+            }
+        }
+        if (victim >= 0){
+            half = (left + 1) / 2;
+            own -> end = schedule -> threads[victim].end;
+            own -> next = own -> end - half;
+            own -> stolen += half;
+            schedule -> threads[victim].end = own -> next;
+        }
+    }
+    chunk = (own -> next < own -> end) ? own -> next++ : -1;
+    pthread_mutex_unlock(&schedule -> lock);
+
+    return chunk;
+}
+
+/*
+ * Adds the chunks stolen to the report of the run
+ */
+void schedule_clear(schedule_t * schedule){
+    int thread, stolen;
+
+    stolen = 0;
+    for(thread = 0; thread < schedule -> num_threads; thread++) stolen += schedule -> threads[thread].stolen;
+    add_stolen_chunks(stolen);
+    free(schedule -> threads);
+    pthread_mutex_destroy(&schedule -> lock);
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include "../../Headers/Common/Seeds.h"
+
+
+/************************************************************************************
+ * Recurrence seeds                                                                 *
+ * A dependency of a series that follows x(k + 1) = x(k) p(k) / q(k), x(0) = 1, is  *
+ * seeded at the starts s_0 <= s_1 <= ... of the blocks in one pass:                *
+ *                                                                                  *
+ *      R_j = p(s_j-1) ... p(s_j - 1) / q(s_j-1) ... q(s_j - 1)                     *
+ *      x(s_j) = R_0 R_1 ... R_j                                                    *
+ *                                                                                  *
+ * The integer products of each segment are computed with a product tree (omp       *
+ * tasks split the big ones) and rounded once, then the prefix products are one     *
+ * multiplication per block. The dependencies that are powers of two, like the ones *
+ * of BBP and Bellard, do not need it: they are seeded exactly with their exponent. *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * p / q = ratio(a) ratio(a + 1) ... ratio(b - 1), with a < b
+ */
+void ratio_product(mpz_t p, mpz_t q, long a, long b, term_ratio_t ratio){
+    long middle;
+    mpz_t p_right, q_right;
+
+    if (b - a == 1){
+        ratio(p, q, a);
+        return;
+    }
+
+    middle = (a + b) / 2;
+    mpz_inits(p_right, q_right, NULL);
+#ifdef _OPENMP
+    #pragma omp task if(b - a > SEED_TASK_TERMS)
+#endif
+    ratio_product(p, q, a, middle, ratio);
+
+    ratio_product(p_right, q_right, middle, b, ratio);
+#ifdef _OPENMP
+    #pragma omp taskwait
+#endif
+
+    mpz_mul(p, p, p_right);
+    mpz_mul(q, q, q_right);
+    mpz_clears(p_right, q_right, NULL);
+}
+
+/*
+ * r = x(b) / x(a) rounded to precision_bits
+ */
+void segment_ratio(mpfr_t r, long a, long b, term_ratio_t ratio, long precision_bits){
+    mpz_t p, q;
+
+    mpfr_init2(r, precision_bits);
+    if (a == b){
+        mpfr_set_ui(r, 1, MPFR_RNDN);
+        return;
+    }
+    mpz_inits(p, q, NULL);
+    ratio_product(p, q, a, b, ratio);
+    mpfr_set_z(r, p, MPFR_RNDN);
+    mpfr_div_z(r, r, q, MPFR_RNDN);
+    mpz_clears(p, q, NULL);
+}
+
+/*
+ * Sets seeds[j] = x(starts[j]) for the non decreasing starts, with the precision
+ * of each seed. The segments are computed by num_threads threads
+ */
+void seed_recurrence(mpfr_t * seeds, const long * starts, int num_seeds, term_ratio_t ratio, 
+                        long precision_bits, int num_threads){
+    int seed;
+    mpfr_t accumulated;
+    mpfr_t * ratios;
+
+    ratios = malloc(num_seeds * sizeof(mpfr_t));
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(num_threads)
+    #pragma omp single
+#else
+    (void) num_threads;
+#endif
+    for(seed = 0; seed < num_seeds; seed++){
+#ifdef _OPENMP
+        #pragma omp task firstprivate(seed)
+#endif
+        segment_ratio(ratios[seed], (seed == 0) ? 0 : starts[seed - 1], starts[seed], ratio, precision_bits);
+    }
+
+    mpfr_init2(accumulated, precision_bits);
+    mpfr_set_ui(accumulated, 1, MPFR_RNDN);
+    for(seed = 0; seed < num_seeds; seed++){
+        mpfr_mul(accumulated, accumulated, ratios[seed], MPFR_RNDN);
+        mpfr_set(seeds[seed], accumulated, MPFR_RNDN);
+        mpfr_clear(ratios[seed]);
+    }
+
+    mpfr_clear(accumulated);
+    free(ratios);
+}
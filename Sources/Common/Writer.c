@@ -0,0 +1,181 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "../../Headers/Common/Writer.h"
+
+
+/************************************************************************************
+ * Streaming writer                                                                 *
+ * The producer copies its data into aligned chunks of WRITER_CHUNK_BYTES and a     *
+ * dedicated thread writes the full ones in order, so the production of the next    *
+ * chunk overlaps with the write of the previous ones:                              *
+ *                                                                                  *
+ *      producer:   fill 0 | fill 1 | fill 2 | fill 3 | fill 0 ...                  *
+ *      writer:            | write 0| write 1| write 2| write 3 ...                 *
+ *                                                                                  *
+ * The file is opened with O_DIRECT where the file system allows it, so the         *
+ * chunks bypass the page cache. The last chunk, which is not aligned, and any      *
+ * file system that rejects O_DIRECT fall back to plain writes.                     *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * Clears O_DIRECT, the next writes go through the page cache
+ */
+void writer_disable_direct(writer_t * writer){
+    fcntl(writer -> fd, F_SETFL, fcntl(writer -> fd, F_GETFL) & ~O_DIRECT);
+    writer -> direct = 0;
+}
+
+/*
+ * Writes length bytes at offset, retrying the partial writes.
+ * Returns 0 if all of them were written and -1 otherwise
+ */
+int writer_pwrite(writer_t * writer, const char * data, long length, long offset){
+    long written;
+
+    if (writer -> direct && length % WRITER_ALIGNMENT != 0) writer_disable_direct(writer);
+    while (length > 0){
+        written = pwrite(writer -> fd, data, length, offset);
+        if (written < 0 && errno == EINTR) continue;
+        if (written < 0 && errno == EINVAL && writer -> direct){
+            writer_disable_direct(writer);
+            continue;
+        }
+        if (written <= 0) return -1;
+        data += written;
+        length -= written;
+        offset += written;
+    }
+    return 0;
+}
+
+/*
+ * Writer thread: writes the full chunks in order until the writer is closed
+ */
+void * writer_thread(void * arg){
+    int chunk;
+    writer_t * writer = (writer_t *) arg;
+
+    pthread_mutex_lock(&writer -> lock);
+    while (1){
+        while (writer -> num_full == 0 && !writer -> closing){
+            pthread_cond_wait(&writer -> full, &writer -> lock);
+        }
+        if (writer -> num_full == 0) break;
+        chunk = writer -> first_full;
+        pthread_mutex_unlock(&writer -> lock);
+
+        if (!writer -> error && writer_pwrite(writer, writer -> buffers[chunk], writer -> lengths[chunk],
+                                                writer -> offset) != 0){
+            writer -> error = 1;
+        }
+        writer -> offset += writer -> lengths[chunk];
+
+        pthread_mutex_lock(&writer -> lock);
+        writer -> first_full = (writer -> first_full + 1) % WRITER_BUFFERS;
+        writer -> num_full--;
+        pthread_cond_signal(&writer -> empty);
+    }
+    pthread_mutex_unlock(&writer -> lock);
+
+    return NULL;
+}
+
+/*
+ * Hands the current chunk to the writer thread and waits for a free one
+ */
+void writer_flush(writer_t * writer){
+    pthread_mutex_lock(&writer -> lock);
+    writer -> lengths[writer -> current] = writer -> fill;
+    writer -> num_full++;
+    pthread_cond_signal(&writer -> full);
+    while (writer -> num_full == WRITER_BUFFERS){
+        pthread_cond_wait(&writer -> empty, &writer -> lock);
+    }
+    writer -> current = (writer -> first_full + writer -> num_full) % WRITER_BUFFERS;
+    pthread_mutex_unlock(&writer -> lock);
+    writer -> fill = 0;
+}
+
+/*
+ * Creates (or truncates) file_name and starts the writer thread.
+ * Returns 0 on success and -1 if the file can not be opened
+ */
+int writer_open(writer_t * writer, const char * file_name){
+    int i;
+
+    writer -> direct = 1;
+    writer -> fd = open(file_name, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    if (writer -> fd < 0 && errno == EINVAL){
+        writer -> direct = 0;
+        writer -> fd = open(file_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (writer -> fd < 0) return -1;
+
+    for(i = 0; i < WRITER_BUFFERS; i++){
+        if (posix_memalign((void **) &writer -> buffers[i], WRITER_ALIGNMENT, WRITER_CHUNK_BYTES) != 0){
+            printf("  Not enough memory for the output buffers \n\n");
+            exit(-1);
+        }
+    }
+    writer -> error = 0;
+    writer -> closing = 0;
+    writer -> offset = 0;
+    writer -> first_full = 0;
+    writer -> num_full = 0;
+    writer -> current = 0;
+    writer -> fill = 0;
+    pthread_mutex_init(&writer -> lock, NULL);
+    pthread_cond_init(&writer -> full, NULL);
+    pthread_cond_init(&writer -> empty, NULL);
+    pthread_create(&writer -> thread, NULL, writer_thread, writer);
+
+    return 0;
+}
+
+/*
+ * Appends length bytes of data to the file
+ */
+void writer_write(writer_t * writer, const char * data, long length){
+    long count;
+
+    while (length > 0){
+        count = WRITER_CHUNK_BYTES - writer -> fill;
+        if (count > length) count = length;
+        memcpy(writer -> buffers[writer -> current] + writer -> fill, data, count);
+        writer -> fill += count;
+        data += count;
+        length -= count;
+        if (writer -> fill == WRITER_CHUNK_BYTES) writer_flush(writer);
+    }
+}
+
+/*
+ * Writes the last chunk, waits for the writer thread and closes the file.
+ * Returns 0 if all the data was written and -1 otherwise
+ */
+int writer_close(writer_t * writer){
+    int i;
+
+    if (writer -> fill > 0) writer_flush(writer);
+    pthread_mutex_lock(&writer -> lock);
+    writer -> closing = 1;
+    pthread_cond_signal(&writer -> full);
+    pthread_mutex_unlock(&writer -> lock);
+    pthread_join(writer -> thread, NULL);
+
+    if (close(writer -> fd) != 0) writer -> error = 1;
+    for(i = 0; i < WRITER_BUFFERS; i++) free(writer -> buffers[i]);
+    pthread_mutex_destroy(&writer -> lock);
+    pthread_cond_destroy(&writer -> full);
+    pthread_cond_destroy(&writer -> empty);
+
+    return (writer -> error) ? -1 : 0;
+}
@@ -0,0 +1,96 @@
+#include <stdint.h>
+#include <string.h>
+#include "../../Headers/Common/Xxhash.h"
+
+#define XXH_PRIME_1 11400714785074694791ULL
+#define XXH_PRIME_2 14029467366897019727ULL
+#define XXH_PRIME_3 1609587929392839161ULL
+#define XXH_PRIME_4 9650029242287828579ULL
+#define XXH_PRIME_5 2870177450012600261ULL
+
+
+/************************************************************************************
+ * xxHash64                                                                         *
+ * Non cryptographic hash of the digit chunks of the manifests. It consumes         *
+ * 32 bytes per step in four independent lanes, so it runs at several bytes         *
+ * per cycle, and it is the same as the reference implementation (XXH64)            *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+static uint64_t rotate_left(uint64_t x, int bits){
+    return (x << bits) | (x >> (64 - bits));
+}
+
+static uint64_t read_64(const unsigned char * p){
+    uint64_t x;
+    memcpy(&x, p, 8);
+    return x;
+}
+
+static uint32_t read_32(const unsigned char * p){
+    uint32_t x;
+    memcpy(&x, p, 4);
+    return x;
+}
+
+static uint64_t xxh_round(uint64_t acc, uint64_t input){
+    acc += input * XXH_PRIME_2;
+    acc = rotate_left(acc, 31);
+    return acc * XXH_PRIME_1;
+}
+
+static uint64_t xxh_merge(uint64_t acc, uint64_t lane){
+    acc ^= xxh_round(0, lane);
+    return acc * XXH_PRIME_1 + XXH_PRIME_4;
+}
+
+uint64_t xxhash64(const void * data, size_t length, uint64_t seed){
+    const unsigned char * p = (const unsigned char *) data;
+    const unsigned char * end = p + length;
+    uint64_t h, v1, v2, v3, v4;
+
+    if (length >= 32){
+        v1 = seed + XXH_PRIME_1 + XXH_PRIME_2;
+        v2 = seed + XXH_PRIME_2;
+        v3 = seed;
+        v4 = seed - XXH_PRIME_1;
+        do {
+            v1 = xxh_round(v1, read_64(p));
+            v2 = xxh_round(v2, read_64(p + 8));
+            v3 = xxh_round(v3, read_64(p + 16));
+            v4 = xxh_round(v4, read_64(p + 24));
+            p += 32;
+        } while (p + 32 <= end);
+        h = rotate_left(v1, 1) + rotate_left(v2, 7) + rotate_left(v3, 12) + rotate_left(v4, 18);
+        h = xxh_merge(h, v1);
+        h = xxh_merge(h, v2);
+        h = xxh_merge(h, v3);
+        h = xxh_merge(h, v4);
+    } else {
+        h = seed + XXH_PRIME_5;
+    }
+    h += (uint64_t) length;
+
+    for(; p + 8 <= end; p += 8){
+        h ^= xxh_round(0, read_64(p));
+        h = rotate_left(h, 27) * XXH_PRIME_1 + XXH_PRIME_4;
+    }
+    if (p + 4 <= end){
+        h ^= (uint64_t) read_32(p) * XXH_PRIME_1;
+        h = rotate_left(h, 23) * XXH_PRIME_2 + XXH_PRIME_3;
+        p += 4;
+    }
+    for(; p < end; p++){
+        h ^= (*p) * XXH_PRIME_5;
+        h = rotate_left(h, 11) * XXH_PRIME_1;
+    }
+
+    //Avalanche
+    h ^= h >> 33;
+    h *= XXH_PRIME_2;
+    h ^= h >> 29;
+    h *= XXH_PRIME_3;
+    h ^= h >> 32;
+    return h;
+}
@@ -6,6 +6,9 @@
 #include "mpi.h"
 #include "../../Headers/Sequential/BBP.h"
 #include "../../Headers/MPI/OperationsMPI.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Report.h"
+#include "../../Headers/Common/Checkpoint.h"
 
 #define QUOTIENT 0.0625
 
@@ -16,18 +19,30 @@
  * so each process calculates a part of pi using threads. 
  * Each process will also divide the iterations in blocks
  * among the threads to calculate its part.  
+ * With tapering the blocks have the same cost instead of the same size.
+ * With a checkpoint file, the blocks of a resumed run are the ones of the
+ * checkpoint and they are shared by the processes and threads, whatever their number.
  * Finally, a collective reduction operation will be performed
  * using a user defined function in OperationsMPI. 
  */
 void BBP_algorithm_MPI(int num_procs, int proc_id, mpfr_t pi, 
                                 int num_iterations, int num_threads, int precision_bits){
-    int block_size, block_start, block_end, position, packet_size, d_elements;
+    int first_unit, last_unit, position, packet_size, d_elements;
+    double started;
+    checkpoint_t checkpoint;
     mpfr_t local_proc_pi, quotient;
 
-    block_size = (num_iterations + num_procs - 1) / num_procs;
-    block_start = proc_id * block_size;
-    block_end = block_start + block_size;
-    if (block_end > num_iterations) block_end = num_iterations;
+    calibrate_cost_model_MPI(proc_id, BBP_probe, precision_bits);
+
+    //The first process creates the checkpoint file before the others read it
+    if (proc_id == 0) checkpoint_begin(&checkpoint, CHECKPOINT_BBP, num_iterations, num_procs * num_threads, 
+                                        precision_bits, BBP_BITS_PER_TERM, 2, 1);
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (proc_id != 0) checkpoint_begin(&checkpoint, CHECKPOINT_BBP, num_iterations, num_procs * num_threads, 
+                                        precision_bits, BBP_BITS_PER_TERM, 2, 0);
+    first_unit = (long) checkpoint.num_units * proc_id / num_procs;
+    last_unit = (long) checkpoint.num_units * (proc_id + 1) / num_procs;
+    checkpoint_start(&checkpoint, first_unit, last_unit);
 
     mpfr_inits2(precision_bits, local_proc_pi, quotient, NULL);
     mpfr_set_d(quotient, QUOTIENT, MPFR_RNDN);
@@ -39,39 +54,54 @@ void BBP_algorithm_MPI(int num_procs, int proc_id, mpfr_t pi,
 
     #pragma omp parallel 
     {
-        int thread_id, i, thread_block_size, thread_block_start, thread_block_end;
+        int thread_id, unit, i, thread_block_start, thread_block_end;
+        long working_precision;
+        double started;
         mpfr_t local_thread_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux;
 
         thread_id = omp_get_thread_num();
-        thread_block_size = (block_size + num_threads - 1) / num_threads;
-        thread_block_start = (thread_id * thread_block_size) + block_start;
-        thread_block_end = thread_block_start + thread_block_size;
-        if (thread_block_end > block_end) thread_block_end = block_end;
-        
-        mpfr_init2(local_thread_pi, precision_bits);               // private thread pi
-        mpfr_set_ui(local_thread_pi, 0, MPFR_RNDN);
-        mpfr_init2(dep_m, precision_bits);
-        mpfr_pow_ui(dep_m, quotient, thread_block_start, MPFR_RNDN);    // m = (1/16)^n                  
-        mpfr_inits2(precision_bits, quot_a, quot_b, quot_c, quot_d, aux, NULL);
-        
-
-        //First Phase -> Working on a local variable        
-        #pragma omp parallel for 
-            for(i = thread_block_start; i < thread_block_end; i++){
-                BBP_iteration(local_thread_pi, i, dep_m, quot_a, quot_b, quot_c, quot_d, aux);
-                // Update dependencies:  
-                mpfr_mul(dep_m, dep_m, quotient, MPFR_RNDN);
+        phase_add(PHASE_SERIES, thread_id, 0);
+        mpfr_inits2(precision_bits, local_thread_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux, NULL);
+
+        #pragma omp for schedule(dynamic, 1)
+        for(unit = first_unit; unit < last_unit; unit++){
+            started = phase_begin();
+            thread_block_start = checkpoint_restore(&checkpoint, unit, local_thread_pi, dep_m, NULL);
+            thread_block_end = checkpoint.units[unit].end;
+            if (thread_block_start < 0){
+                thread_block_start = checkpoint.units[unit].start;
+                set_term_precision(precision_bits, local_thread_pi, dep_m, NULL);
+                mpfr_set_ui(local_thread_pi, 0, MPFR_RNDN);         // private thread pi
+                mpfr_set_ui_2exp(dep_m, 1, -4L * thread_block_start, MPFR_RNDN);    // m = (1/16)^n
             }
 
-        //Second Phase -> Accumulate the result in the global variable
-        #pragma omp critical
-        mpfr_add(local_proc_pi, local_proc_pi, local_thread_pi, MPFR_RNDN);
+            //First Phase -> Working on a local variable        
+            #pragma omp parallel for 
+                for(i = thread_block_start; i < thread_block_end; i++){
+                    working_precision = term_precision(precision_bits, i, BBP_BITS_PER_TERM);
+                    set_term_precision(working_precision, quot_a, quot_b, quot_c, quot_d, aux, NULL);
+                    round_term_precision(working_precision, dep_m, NULL);
+                    BBP_iteration(local_thread_pi, i, dep_m, quot_a, quot_b, quot_c, quot_d, aux);
+                    // Update dependencies:  
+                    mpfr_mul(dep_m, dep_m, quotient, MPFR_RNDN);
+                    checkpoint_save(&checkpoint, unit, i + 1, local_thread_pi, dep_m, NULL);
+                }
+            phase_end(PHASE_SERIES, thread_id, started);
+
+            //Second Phase -> Accumulate the result in the global variable
+            started = phase_begin();
+            #pragma omp critical
+            mpfr_add(local_proc_pi, local_proc_pi, local_thread_pi, MPFR_RNDN);
+            phase_end(PHASE_THREAD_REDUCTION, thread_id, started);
+        }
 
         //Clear thread memory
         mpfr_free_cache();
         mpfr_clears(local_thread_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux, NULL);   
     }
 
+    checkpoint_end(&checkpoint);
+
     //Create user defined operation
     MPI_Op add_op;
     MPI_Op_create((MPI_User_function *)add, 0, &add_op);
@@ -83,14 +113,17 @@ void BBP_algorithm_MPI(int num_procs, int proc_id, mpfr_t pi,
     char sendbuffer[packet_size];
 
     //Pack local_proc_pi in sendbuffuer
+    started = phase_begin();
     position = pack(sendbuffer, local_proc_pi);
 
     //Reduce piLocal
     MPI_Reduce(sendbuffer, recbuffer, position, MPI_PACKED, add_op, 0, MPI_COMM_WORLD);
+    phase_end(PHASE_MPI_REDUCTION, 0, started);
 
     //Unpack recbuffer in global Pi and do the last operation
     if (proc_id == 0){
         unpack(recbuffer, pi);
+        checkpoint_remove(&checkpoint);
     }
 
     //Clear memory
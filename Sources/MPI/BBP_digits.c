@@ -0,0 +1,54 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include "mpi.h"
+#include "../../Headers/Sequential/BBP_digits.h"
+
+
+/*
+ * Parallel computation of the hex digits of pi after position
+ * The range of k is divided by blocks, 
+ * so each process computes a part of the sum using threads. 
+ * Each process will also divide its block among the threads.
+ * Finally, the partial sums are added with a reduction 
+ * and the process 0 gets the hex digits.
+ */
+void BBP_hex_digits_MPI(int num_procs, int proc_id, char * hex, long position, int num_threads){
+    long num_terms, block_size, block_start, block_end;
+    long double local_proc_sum, sum;
+
+    num_terms = position + 1 + BBP_TAIL_TERMS;
+    block_size = (num_terms + num_procs - 1) / num_procs;
+    block_start = proc_id * block_size;
+    block_end = block_start + block_size;
+    if (block_end > num_terms) block_end = num_terms;
+    local_proc_sum = 0;
+
+    //Set the number of threads 
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel reduction(+:local_proc_sum)
+    {
+        int thread_id;
+        long thread_block_size, thread_block_start, thread_block_end;
+
+        thread_id = omp_get_thread_num();
+        thread_block_size = (block_size + num_threads - 1) / num_threads;
+        thread_block_start = (thread_id * thread_block_size) + block_start;
+        thread_block_end = thread_block_start + thread_block_size;
+        if (thread_block_end > block_end) thread_block_end = block_end;
+
+        if (thread_block_start < thread_block_end){
+            local_proc_sum += BBP_digits_partial(position, thread_block_start, thread_block_end);
+        }
+    }
+
+    //Add the partial sums of the processes
+    local_proc_sum -= floorl(local_proc_sum);
+    MPI_Reduce(&local_proc_sum, &sum, 1, MPI_LONG_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    if (proc_id == 0){
+        BBP_fraction_to_hex(hex, sum);
+    }
+}
@@ -6,6 +6,8 @@
 #include "mpi.h"
 #include "../../Headers/Sequential/Bellard_v1.h"
 #include "../../Headers/MPI/OperationsMPI.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Report.h"
 
 
 /*
@@ -14,18 +16,18 @@
  * so each process calculates a part of pi using threads. 
  * Each process will cyclically divide the iterations 
  * among the threads to calculate its part.  
+ * With tapering the process blocks have the same cost instead of the same size.
  * Finally, a collective reduction operation will be performed
  * using a user defined function in OperationsMPI. 
  */
 void Bellard_algorithm_v1_MPI(int num_procs, int proc_id, mpfr_t pi, 
                                 int num_iterations, int num_threads, int precision_bits){
-    int block_size, block_start, block_end, position, packet_size, d_elements;
+    int block_start, block_end, position, packet_size, d_elements;
+    double started;
     mpfr_t local_proc_pi, jump;
 
-    block_size = (num_iterations + num_procs - 1) / num_procs;
-    block_start = proc_id * block_size;
-    block_end = block_start + block_size;
-    if (block_end > num_iterations) block_end = num_iterations;
+    calibrate_cost_model_MPI(proc_id, Bellard_v1_probe, precision_bits);
+    taper_block(0, num_iterations, num_procs, proc_id, precision_bits, BELLARD_BITS_PER_TERM, &block_start, &block_end);
 
     mpfr_inits2(precision_bits, jump, local_proc_pi, NULL);
     mpfr_set_ui(local_proc_pi, 0, MPFR_RNDN);
@@ -39,9 +41,12 @@ void Bellard_algorithm_v1_MPI(int num_procs, int proc_id, mpfr_t pi,
     #pragma omp parallel 
     {
         int thread_id, i, dep_a, dep_b, jump_dep_a, jump_dep_b;
+        long working_precision;
+        double started;
         mpfr_t local_thread_pi, dep_m, a, b, c, d, e, f, g, aux;
 
         thread_id = omp_get_thread_num();
+        phase_add(PHASE_SERIES, thread_id, 0);
 
         mpfr_init2(local_thread_pi, precision_bits);               // private thread pi
         mpfr_set_ui(local_thread_pi, 0, MPFR_RNDN);
@@ -50,16 +55,18 @@ void Bellard_algorithm_v1_MPI(int num_procs, int proc_id, mpfr_t pi,
         jump_dep_a = 4 * num_threads;
         jump_dep_b = 10 * num_threads;
         mpfr_init2(dep_m, precision_bits);
-        mpfr_set_ui(dep_m, 1, MPFR_RNDN);
-        mpfr_div_ui(dep_m, dep_m, 1024, MPFR_RNDN);
-        mpfr_pow_ui(dep_m, dep_m, block_start + thread_id, MPFR_RNDN);        // dep_m = ((-1)^n)/1024)
-        if((block_start + thread_id) % 2 != 0) mpfr_neg(dep_m, dep_m, MPFR_RNDN);                   
+        mpfr_set_si_2exp(dep_m, ((block_start + thread_id) % 2 != 0) ? -1 : 1, -10L * (block_start + thread_id), 
+                            MPFR_RNDN);         // dep_m = ((-1)^n)/1024^n)
         mpfr_inits2(precision_bits, a, b, c, d, e, f, g, aux, NULL);
 
         //First Phase -> Working on a local variable
+        started = phase_begin();
         if(num_threads % 2 != 0){
             #pragma omp parallel for 
                 for(i = block_start + thread_id; i < block_end; i+=num_threads){
+                    working_precision = term_precision(precision_bits, i, BELLARD_BITS_PER_TERM);
+                    set_term_precision(working_precision, a, b, c, d, e, f, g, aux, NULL);
+                    round_term_precision(working_precision, dep_m, NULL);
                     Bellard_iteration_v1(local_thread_pi, i, dep_m, a, b, c, d, e, f, g, aux, dep_a, dep_b);
                     // Update dependencies for next iteration:
                     mpfr_mul(dep_m, dep_m, jump, MPFR_RNDN); 
@@ -70,6 +77,9 @@ void Bellard_algorithm_v1_MPI(int num_procs, int proc_id, mpfr_t pi,
         } else {
             #pragma omp parallel for
                 for(i = block_start + thread_id; i < block_end; i+=num_threads){
+                    working_precision = term_precision(precision_bits, i, BELLARD_BITS_PER_TERM);
+                    set_term_precision(working_precision, a, b, c, d, e, f, g, aux, NULL);
+                    round_term_precision(working_precision, dep_m, NULL);
                     Bellard_iteration_v1(local_thread_pi, i, dep_m, a, b, c, d, e, f, g, aux, dep_a, dep_b);
                     // Update dependencies for next iteration:
                     mpfr_mul(dep_m, dep_m, jump, MPFR_RNDN);    
@@ -77,10 +87,13 @@ void Bellard_algorithm_v1_MPI(int num_procs, int proc_id, mpfr_t pi,
                     dep_b += jump_dep_b;  
                 }
         }
+        phase_end(PHASE_SERIES, thread_id, started);
 
         //Second Phase -> Accumulate the result in the global variable
+        started = phase_begin();
         #pragma omp critical
         mpfr_add(local_proc_pi, local_proc_pi, local_thread_pi, MPFR_RNDN);
+        phase_end(PHASE_THREAD_REDUCTION, thread_id, started);
 
         //Clear thread memory
         mpfr_free_cache();
@@ -98,15 +111,19 @@ void Bellard_algorithm_v1_MPI(int num_procs, int proc_id, mpfr_t pi,
     char sendbuffer[packet_size];
 
     //Pack local_proc_pi in sendbuffuer
+    started = phase_begin();
     position = pack(sendbuffer, local_proc_pi);
 
     //Reduce piLocal
     MPI_Reduce(sendbuffer, recbuffer, position, MPI_PACKED, add_op, 0, MPI_COMM_WORLD);
+    phase_end(PHASE_MPI_REDUCTION, 0, started);
 
     //Unpack recbuffer in global Pi and do the last operation
     if (proc_id == 0){
         unpack(recbuffer, pi);
+        started = phase_begin();
         mpfr_div_ui(pi, pi, 64, MPFR_RNDN);
+        phase_end(PHASE_FINAL, 0, started);
     }
 
     //Clear memory
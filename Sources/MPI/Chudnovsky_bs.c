@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "mpi.h"
+#include "../../Headers/Sequential/Chudnovsky_bs.h"
+#include "../../Headers/MPI/OperationsMPI.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Report.h"
+
+
+/*
+ * Parallel Pi number calculation using the Chudnovsky algorithm
+ * with binary splitting. 
+ * The number of iterations is divided by blocks, so each process 
+ * computes the exact P, Q and T integers of its block using threads.
+ * Each thread computes P, Q and T for a part of the block and 
+ * the results of the threads are merged in pairs. 
+ * Finally, the results of the processes are merged through a tree 
+ * of sends and receives, so the process 0 gets P, Q and T of all the 
+ * terms and computes pi with a single division and square root.
+ * P is not computed for the merges that reach the last term, 
+ * so the processes whose merged blocks reach the last term do not send it.
+ */
+void Chudnovsky_algorithm_bs_MPI(int num_procs, int proc_id, mpfr_t pi, 
+                                    int num_iterations, int num_threads, int precision_bits){
+    int block_start, block_end, i, step, last_proc;
+    double started;
+    mpz_t * P, * Q, * T;
+    mpz_t P2, Q2, T2;
+
+    (void) precision_bits;      // The precision of pi is enough for the last operation
+
+    even_block(0, num_iterations, num_procs, proc_id, &block_start, &block_end);
+    last_proc = (proc_id == num_procs - 1);
+
+    P = malloc(num_threads * sizeof(mpz_t));
+    Q = malloc(num_threads * sizeof(mpz_t));
+    T = malloc(num_threads * sizeof(mpz_t));
+
+    //Set the number of threads 
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel 
+    {
+        int thread_id, thread_block_start, thread_block_end;
+        double started;
+
+        thread_id = omp_get_thread_num();
+        started = phase_begin();
+        even_block(block_start, block_end, num_threads, thread_id, &thread_block_start, &thread_block_end);
+
+        //First Phase -> P, Q and T of the thread block (empty blocks are P = Q = 1, T = 0)
+        mpz_init_set_ui(P[thread_id], 1);
+        mpz_init_set_ui(Q[thread_id], 1);
+        mpz_init_set_ui(T[thread_id], 0);
+        if (thread_block_start < thread_block_end){
+            Chudnovsky_bs(thread_block_start, thread_block_end, P[thread_id], Q[thread_id], T[thread_id]);
+        }
+        phase_end(PHASE_SERIES, thread_id, started);
+    }
+
+    //Second Phase -> Merge the thread blocks in pairs
+    for(step = 1; step < num_threads; step *= 2){
+        #pragma omp parallel for
+            for(i = 0; i < num_threads - step; i += 2 * step){
+                double started = phase_begin();
+                Chudnovsky_bs_merge(P[i], Q[i], T[i], P[i + step], Q[i + step], T[i + step], 
+                                    !last_proc || i + 2 * step < num_threads);
+                phase_end(PHASE_THREAD_REDUCTION, omp_get_thread_num(), started);
+            }
+    }
+    for(i = 1; i < num_threads; i++){
+        mpz_clears(P[i], Q[i], T[i], NULL);
+    }
+
+    //Third Phase -> Merge the process blocks through a tree of communications
+    started = phase_begin();
+    mpz_inits(P2, Q2, T2, NULL);
+    for(step = 1; step < num_procs; step *= 2){
+        if (proc_id % (2 * step) != 0){
+            if (proc_id + step < num_procs) send_mpz(P[0], proc_id - step, 0);
+            send_mpz(Q[0], proc_id - step, 1);
+            send_mpz(T[0], proc_id - step, 2);
+            break;
+        } 
+        if (proc_id + step < num_procs){
+            if (proc_id + 2 * step < num_procs) recv_mpz(P2, proc_id + step, 0);
+            recv_mpz(Q2, proc_id + step, 1);
+            recv_mpz(T2, proc_id + step, 2);
+            Chudnovsky_bs_merge(P[0], Q[0], T[0], P2, Q2, T2, proc_id + 2 * step < num_procs);
+        }
+    }
+    phase_end(PHASE_MPI_REDUCTION, 0, started);
+
+    //Process 0 does the last operation
+    if (proc_id == 0){
+        started = phase_begin();
+        Chudnovsky_bs_pi(pi, Q[0], T[0]);
+        phase_end(PHASE_FINAL, 0, started);
+    }
+
+    //Clear memory
+    mpz_clears(P[0], Q[0], T[0], P2, Q2, T2, NULL);
+    free(P);
+    free(Q);
+    free(T);
+}
@@ -6,6 +6,9 @@
 #include "mpi.h"
 #include "../../Headers/Sequential/Chudnovsky_v2.h"
 #include "../../Headers/MPI/OperationsMPI.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Report.h"
+#include "../../Headers/Common/Checkpoint.h"
 
 #define A 13591409
 #define B 545140134
@@ -14,51 +17,45 @@
 #define E 10005
 
 
-/*
- * This method is used by Chudnovsky_algorithm_MPI threads
- * for computing the first value of dep_a
- */
-void init_dep_a(mpfr_t dep_a, int block_start, int precision_bits){
-    mpz_t factorial_n, dividend, divisor;
-    mpfr_t float_dividend, float_divisor;
-    mpz_inits(factorial_n, dividend, divisor, NULL);
-    mpfr_inits2(precision_bits ,float_dividend, float_divisor, NULL);
-
-    mpz_fac_ui(factorial_n, block_start);
-    mpz_fac_ui(divisor, 3 * block_start);
-    mpz_fac_ui(dividend, 6 * block_start);
-
-    mpz_pow_ui(factorial_n, factorial_n, 3);
-    mpz_mul(divisor, divisor, factorial_n);
-
-    mpfr_set_z(float_dividend, dividend, MPFR_RNDN);
-    mpfr_set_z(float_divisor, divisor, MPFR_RNDN);
-
-    mpfr_div(dep_a, float_dividend, float_divisor, MPFR_RNDN);
-
-    mpz_clears(factorial_n, dividend, divisor, NULL);
-    mpfr_clears(float_dividend, float_divisor, NULL);
-}
-
-
 /*
  * Parallel Pi number calculation using the Chudnovsky algorithm
  * The number of iterations is divided by blocks 
  * so each process calculates a part of pi with multiple threads (or just one thread). 
  * Each process will also divide the iterations in blocks
  * among the threads to calculate its part.  
+ * With tapering the blocks have the same cost instead of the same size.
+ * The dependencies at the start of the blocks of each process are 
+ * computed in one pass.
+ * With a checkpoint file, the blocks of a resumed run are the ones of the
+ * checkpoint and they are shared by the processes and threads, whatever their number.
  * Finally, a collective reduction operation will be performed 
  * using a user defined function in OperationsMPI. 
  */
 void Chudnovsky_algorithm_v2_MPI(int num_procs, int proc_id, mpfr_t pi, 
                                     int num_iterations, int num_threads, int precision_bits){
-    int block_size, block_start, block_end, position, packet_size, d_elements;
+    int first_unit, last_unit, position, packet_size, d_elements, seed, * units;
+    double started;
+    checkpoint_t checkpoint;
+    Chudnovsky_seeds_t seeds;
     mpfr_t local_proc_pi, e, c;
 
-    block_size = (num_iterations + num_procs - 1) / num_procs;
-    block_start = proc_id * block_size;
-    block_end = block_start + block_size;
-    if (block_end > num_iterations) block_end = num_iterations;
+    calibrate_cost_model_MPI(proc_id, Chudnovsky_probe, precision_bits);
+
+    //The first process creates the checkpoint file before the others read it
+    if (proc_id == 0) checkpoint_begin(&checkpoint, CHECKPOINT_CHUDNOVSKY, num_iterations, num_procs * num_threads, 
+                                        precision_bits, CHUDNOVSKY_BITS_PER_TERM, 4, 1);
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (proc_id != 0) checkpoint_begin(&checkpoint, CHECKPOINT_CHUDNOVSKY, num_iterations, num_procs * num_threads, 
+                                        precision_bits, CHUDNOVSKY_BITS_PER_TERM, 4, 0);
+    first_unit = (long) checkpoint.num_units * proc_id / num_procs;
+    last_unit = (long) checkpoint.num_units * (proc_id + 1) / num_procs;
+    checkpoint_start(&checkpoint, first_unit, last_unit);
+    started = phase_begin();
+    units = malloc((last_unit - first_unit) * sizeof(int));
+    for(seed = 0; seed < last_unit - first_unit; seed++) units[seed] = first_unit + seed;
+    init_Chudnovsky_seeds(&seeds, &checkpoint, units, last_unit - first_unit, precision_bits, num_threads);
+    free(units);
+    phase_end(PHASE_SEEDING, 0, started);
 
     mpfr_inits2(precision_bits, local_proc_pi, e, c, NULL);
     mpfr_set_ui(local_proc_pi, 0, MPFR_RNDN);
@@ -72,57 +69,62 @@ void Chudnovsky_algorithm_v2_MPI(int num_procs, int proc_id, mpfr_t pi,
 
     #pragma omp parallel 
     {
-        int thread_id, i, thread_block_size, thread_block_start, thread_block_end, factor_a;
+        int thread_id, unit, i, thread_block_start, thread_block_end;
+        long working_precision;
+        double started;
         mpfr_t local_thread_pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux;
 
         thread_id = omp_get_thread_num();
-        thread_block_size = (block_size + num_threads - 1) / num_threads;
-        thread_block_start = (thread_id * thread_block_size) + block_start;
-        thread_block_end = thread_block_start + thread_block_size;
-        if (thread_block_end > block_end) thread_block_end = block_end;
-
-        mpfr_init2(local_thread_pi, precision_bits);    // private thread pi
-        mpfr_set_ui(local_thread_pi, 0, MPFR_RNDN);
-        mpfr_inits2(precision_bits, dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);
-        init_dep_a(dep_a, thread_block_start, precision_bits);
-        mpfr_pow_ui(dep_b, c, thread_block_start, MPFR_RNDN);
-        mpfr_set_ui(dep_c, B, MPFR_RNDN);
-        mpfr_mul_ui(dep_c, dep_c, thread_block_start, MPFR_RNDN);
-        mpfr_add_ui(dep_c, dep_c, A, MPFR_RNDN);
-        factor_a = 12 * thread_block_start;
-
-
-        //First Phase -> Working on a local variable        
-        #pragma omp parallel for 
-            for(i = thread_block_start; i < thread_block_end; i++){
-                Chudnovsky_iteration(local_thread_pi, i, dep_a, dep_b, dep_c, aux);
-                //Update dep_a:
-                mpfr_set_ui(dep_a_dividend, factor_a + 10, MPFR_RNDN);
-                mpfr_mul_ui(dep_a_dividend, dep_a_dividend, factor_a + 6, MPFR_RNDN);
-                mpfr_mul_ui(dep_a_dividend, dep_a_dividend, factor_a + 2, MPFR_RNDN);
-                mpfr_mul(dep_a_dividend, dep_a_dividend, dep_a, MPFR_RNDN);
-
-                mpfr_set_ui(dep_a_divisor, i + 1, MPFR_RNDN);
-                mpfr_pow_ui(dep_a_divisor, dep_a_divisor , 3, MPFR_RNDN);
-                mpfr_div(dep_a, dep_a_dividend, dep_a_divisor, MPFR_RNDN);
-                factor_a += 12;
-
-                //Update dep_b:
-                mpfr_mul(dep_b, dep_b, c, MPFR_RNDN);
-
-                //Update dep_c:
-                mpfr_add_ui(dep_c, dep_c, B, MPFR_RNDN);
+        phase_add(PHASE_SERIES, thread_id, 0);
+        mpfr_inits2(precision_bits, local_thread_pi, dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);
+
+        #pragma omp for schedule(dynamic, 1)
+        for(unit = first_unit; unit < last_unit; unit++){
+            started = phase_begin();
+            thread_block_start = checkpoint_restore(&checkpoint, unit, local_thread_pi, dep_a, dep_b, dep_c, NULL);
+            thread_block_end = checkpoint.units[unit].end;
+            if (thread_block_start < 0){
+                thread_block_start = checkpoint.units[unit].start;
+                set_term_precision(precision_bits, local_thread_pi, NULL);
+                mpfr_set_ui(local_thread_pi, 0, MPFR_RNDN);     // private thread pi
+                set_Chudnovsky_seed(&seeds, &checkpoint, unit, precision_bits, dep_a, dep_b, dep_c);
             }
 
-        //Second Phase -> Accumulate the result in the global variable
-        #pragma omp critical
-        mpfr_add(local_proc_pi, local_proc_pi, local_thread_pi, MPFR_RNDN);
+
+            //First Phase -> Working on a local variable        
+            #pragma omp parallel for 
+                for(i = thread_block_start; i < thread_block_end; i++){
+                    working_precision = term_precision(precision_bits, i, CHUDNOVSKY_BITS_PER_TERM);
+                    set_term_precision(working_precision, dep_a_dividend, dep_a_divisor, aux, NULL);
+                    round_term_precision(working_precision, dep_a, dep_b, dep_c, NULL);
+                    Chudnovsky_iteration(local_thread_pi, i, dep_a, dep_b, dep_c, aux);
+                    //Update dep_a:
+                    Chudnovsky_update_a(dep_a, i, dep_a_dividend, dep_a_divisor);
+
+                    //Update dep_b:
+                    mpfr_mul(dep_b, dep_b, c, MPFR_RNDN);
+
+                    //Update dep_c:
+                    mpfr_add_ui(dep_c, dep_c, B, MPFR_RNDN);
+                    checkpoint_save(&checkpoint, unit, i + 1, local_thread_pi, dep_a, dep_b, dep_c, NULL);
+                }
+            phase_end(PHASE_SERIES, thread_id, started);
+
+            //Second Phase -> Accumulate the result in the global variable
+            started = phase_begin();
+            #pragma omp critical
+            mpfr_add(local_proc_pi, local_proc_pi, local_thread_pi, MPFR_RNDN);
+            phase_end(PHASE_THREAD_REDUCTION, thread_id, started);
+        }
 
         //Clear thread memory
         mpfr_free_cache();
         mpfr_clears(local_thread_pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux, NULL); 
     }
 
+    checkpoint_end(&checkpoint);
+    clear_Chudnovsky_seeds(&seeds);
+
      //Create user defined operation
     MPI_Op add_op;
     MPI_Op_create((MPI_User_function *)add, 0, &add_op);
@@ -134,17 +136,22 @@ void Chudnovsky_algorithm_v2_MPI(int num_procs, int proc_id, mpfr_t pi,
     char sendbuffer[packet_size];
 
     //Pack local_proc_pi in sendbuffuer
+    started = phase_begin();
     position = pack(sendbuffer, local_proc_pi);
 
     //Reduce piLocal
     MPI_Reduce(sendbuffer, recbuffer, position, MPI_PACKED, add_op, 0, MPI_COMM_WORLD);
+    phase_end(PHASE_MPI_REDUCTION, 0, started);
 
     //Unpack recbuffer in global Pi and do the last operation
     if (proc_id == 0){
         unpack(recbuffer, pi);
+        checkpoint_remove(&checkpoint);
+        started = phase_begin();
         mpfr_sqrt(e, e, MPFR_RNDN);
         mpfr_mul_ui(e, e, D, MPFR_RNDN);
         mpfr_div(pi, e, pi, MPFR_RNDN); 
+        phase_end(PHASE_FINAL, 0, started);
     }
 
     //Clear memory
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include <math.h>
+#include "mpi.h"
+#include "../../Headers/Sequential/Fixed_point.h"
+#include "../../Headers/MPI/OperationsMPI.h"
+#include "../../Headers/Common/Report.h"
+
+
+/*
+ * Parallel Pi number calculation with a fixed point series
+ * The cost of a term decreases with n, so the iterations are cyclically
+ * divided among all the threads of all the processes.
+ * Each thread adds its terms in a private fixed point sum, the sums
+ * of the threads are added and converted to mpfr in each process.
+ * Finally, a collective reduction operation will be performed
+ * using a user defined function in OperationsMPI.
+ */
+void Fixed_point_algorithm_MPI(int num_procs, int proc_id, mpfr_t pi, const fixed_series_t * series,
+                                int num_iterations, int num_threads, int precision_bits){
+    int position, packet_size, d_elements;
+    double started;
+    mp_size_t size;
+    mp_ptr proc_sum;
+    mpfr_t local_proc_pi;
+
+    size = Fixed_point_size(precision_bits);
+    proc_sum = calloc(size, sizeof(mp_limb_t));
+    mpfr_init2(local_proc_pi, precision_bits);
+
+    //Set the number of threads
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel
+    {
+        int thread_id;
+        double started;
+        mp_ptr local_sum;
+
+        thread_id = omp_get_thread_num();
+        started = phase_begin();
+        local_sum = calloc(size, sizeof(mp_limb_t));             // private thread sum
+
+        //First Phase -> Working on a local variable
+        Fixed_point_sum(local_sum, size, series, proc_id * num_threads + thread_id, num_iterations,
+                            num_procs * num_threads);
+        phase_end(PHASE_SERIES, thread_id, started);
+
+        //Second Phase -> Accumulate the result in the process variable
+        started = phase_begin();
+        #pragma omp critical
+        mpn_add_n(proc_sum, proc_sum, local_sum, size);
+        phase_end(PHASE_THREAD_REDUCTION, thread_id, started);
+
+        //Clear thread memory
+        free(local_sum);
+    }
+    started = phase_begin();
+    Fixed_point_to_mpfr(local_proc_pi, proc_sum, size);
+    phase_end(PHASE_FINAL, 0, started);
+
+    //Create user defined operation
+    MPI_Op add_op;
+    MPI_Op_create((MPI_User_function *)add, 0, &add_op);
+
+    //Set buffers for cumunications and position for pack and unpack information
+    d_elements = (int) ceil((float) local_proc_pi -> _mpfr_prec / (float) GMP_NUMB_BITS);
+    packet_size = 8 + sizeof(mpfr_exp_t) + (d_elements * sizeof(mp_limb_t));
+    char * recbuffer = malloc(packet_size);
+    char * sendbuffer = malloc(packet_size);
+
+    //Pack local_proc_pi in sendbuffuer
+    started = phase_begin();
+    position = pack(sendbuffer, local_proc_pi);
+
+    //Reduce piLocal
+    MPI_Reduce(sendbuffer, recbuffer, position, MPI_PACKED, add_op, 0, MPI_COMM_WORLD);
+
+    //Unpack recbuffer in global Pi
+    if (proc_id == 0){
+        unpack(recbuffer, pi);
+    }
+    phase_end(PHASE_MPI_REDUCTION, 0, started);
+
+    //Clear memory
+    MPI_Op_free(&add_op);
+    free(recbuffer);
+    free(sendbuffer);
+    free(proc_sum);
+    mpfr_clear(local_proc_pi);
+}
@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include <math.h>
+#include "mpi.h"
+#include "../../Headers/Sequential/Series_bs.h"
+#include "../../Headers/Sequential/Machin.h"
+#include "../../Headers/MPI/Series_bs.h"
+#include "../../Headers/MPI/OperationsMPI.h"
+#include "../../Headers/Common/Report.h"
+
+
+/*
+ * Parallel Pi number calculation using a Machin-like formula
+ * The arctangents are independent, so they are cyclically divided
+ * among the processes (processes beyond the number of arctangents
+ * have nothing to do). Each process evaluates the series of its
+ * arctangents with threads (Series_bs_threads).
+ * Finally, a collective reduction operation will be performed
+ * using a user defined function in OperationsMPI.
+ */
+void Machin_algorithm_MPI(int num_procs, int proc_id, mpfr_t pi, const machin_t * formula,
+                                int precision, int num_threads, int precision_bits){
+    int j, position, packet_size, d_elements;
+    double started;
+    series_t series;
+    mpz_t P, Q, B, T;
+    mpfr_t local_proc_pi, term;
+
+    mpz_inits(P, Q, B, T, NULL);
+    mpfr_inits2(precision_bits, local_proc_pi, term, NULL);
+    mpfr_set_ui(local_proc_pi, 0, MPFR_RNDN);
+
+    for(j = proc_id; j < formula -> num_terms; j += num_procs){
+        arctan_series(&series, formula -> ks[j]);
+        Series_bs_threads(&series, 0, arctan_iterations(formula -> ks[j], precision), num_threads, P, Q, B, T);
+        started = phase_begin();
+        Machin_term_value(term, formula, j, Q, B, T);
+        mpfr_add(local_proc_pi, local_proc_pi, term, MPFR_RNDN);
+        phase_end(PHASE_FINAL, 0, started);
+    }
+
+    //Create user defined operation
+    MPI_Op add_op;
+    MPI_Op_create((MPI_User_function *)add, 0, &add_op);
+
+    //Set buffers for cumunications and position for pack and unpack information
+    d_elements = (int) ceil((float) local_proc_pi -> _mpfr_prec / (float) GMP_NUMB_BITS);
+    packet_size = 8 + sizeof(mpfr_exp_t) + (d_elements * sizeof(mp_limb_t));
+    char * recbuffer = malloc(packet_size);
+    char * sendbuffer = malloc(packet_size);
+
+    //Pack local_proc_pi in sendbuffuer
+    started = phase_begin();
+    position = pack(sendbuffer, local_proc_pi);
+
+    //Reduce piLocal
+    MPI_Reduce(sendbuffer, recbuffer, position, MPI_PACKED, add_op, 0, MPI_COMM_WORLD);
+
+    //Unpack recbuffer in global Pi
+    if (proc_id == 0){
+        unpack(recbuffer, pi);
+    }
+    phase_end(PHASE_MPI_REDUCTION, 0, started);
+
+    //Clear memory
+    MPI_Op_free(&add_op);
+    free(recbuffer);
+    free(sendbuffer);
+    mpz_clears(P, Q, B, T, NULL);
+    mpfr_clears(local_proc_pi, term, NULL);
+}
@@ -3,6 +3,7 @@
 #include <math.h>
 #include <mpfr.h>
 #include "mpi.h"
+#include "../../Headers/Common/Precision.h"
 
 /*
  * Pack mpf_t type
@@ -36,6 +37,48 @@ void unpack(void * buffer, mpfr_t data){
 }
 
 
+/*
+ * The limbs of a mpz_t are sent in messages of at most LIMBS_PER_MESSAGE
+ * elements, so the int count of MPI never overflows with huge numbers
+ */
+#define LIMBS_PER_MESSAGE (1L << 26)
+#define MPI_LIMB ((sizeof(mp_limb_t) == 8) ? MPI_UINT64_T : MPI_UINT32_T)
+
+/*
+ * Send mpz_t type to process dest
+ * The size is sent first with the sign of the number and then the limbs
+ */
+void send_mpz(mpz_t data, int dest, int tag){
+    long size, num_limbs, sent, count;
+    const mp_limb_t * limbs;
+    num_limbs = mpz_size(data);
+    size = (mpz_sgn(data) < 0) ? -num_limbs : num_limbs;
+    MPI_Send(&size, 1, MPI_LONG, dest, tag, MPI_COMM_WORLD);
+    limbs = mpz_limbs_read(data);
+    for(sent = 0; sent < num_limbs; sent += count){
+        count = (num_limbs - sent < LIMBS_PER_MESSAGE) ? num_limbs - sent : LIMBS_PER_MESSAGE;
+        MPI_Send(limbs + sent, (int) count, MPI_LIMB, dest, tag, MPI_COMM_WORLD);
+    }
+}
+
+/*
+ * Receive mpz_t type from process source
+ * IMPORTANT: mpz_t data should have been previously initialized
+ */
+void recv_mpz(mpz_t data, int source, int tag){
+    long size, num_limbs, received, count;
+    mp_limb_t * limbs;
+    MPI_Recv(&size, 1, MPI_LONG, source, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    num_limbs = (size < 0) ? -size : size;
+    limbs = mpz_limbs_write(data, (num_limbs > 0) ? num_limbs : 1);
+    for(received = 0; received < num_limbs; received += count){
+        count = (num_limbs - received < LIMBS_PER_MESSAGE) ? num_limbs - received : LIMBS_PER_MESSAGE;
+        MPI_Recv(limbs + received, (int) count, MPI_LIMB, source, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
+    mpz_limbs_finish(data, size);
+}
+
+
 /*
  * Operation defined for MPI
  * Adds mpf_t types
@@ -64,5 +107,18 @@ void mul(void * invec, void * inoutvec, int *len, MPI_Datatype *dtype){
     mpfr_clears(a, b, NULL);
 }
 
+/*
+ * The first process calibrates the cost model and sends it to the others,
+ * so all of them split the iterations in the same blocks
+ */
+void calibrate_cost_model_MPI(int proc_id, term_probe_t probe, long precision_bits){
+    double model[2];
 
-
+    if (!get_precision_tapering()) return;
+    if (proc_id == 0){
+        calibrate_cost_model(probe, precision_bits);
+        get_cost_model(&model[0], &model[1]);
+    }
+    MPI_Bcast(model, 2, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    set_cost_model(model[0], model[1]);
+}
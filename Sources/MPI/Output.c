@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include "mpi.h"
+#include "../../Headers/MPI/Output.h"
+#include "../../Headers/MPI/OperationsMPI.h"
+#include "../../Headers/Common/Decimal_conversion.h"
+
+typedef struct {
+    MPI_File file;
+    MPI_Request request;                    // Write of the previous chunk
+    char * buffers[2];
+    int current, rounds;
+    long fill, offset;
+    long digits;                            // Digits of the segment converted
+    long point;                             // The decimal point goes before this digit
+} segment_stream_t;
+
+
+/************************************************************************************
+ * Distributed decimal conversion and output                                        *
+ * The digits of z = floor(pi 10^d) are divided in num_procs segments. Process 0    *
+ * holds z and splits it by the top level powers of 10 along a binary tree:         *
+ *                                                                                  *
+ *      processes [lo, hi) own z  ->  z = q 10^(digits of [mid, hi)) + r            *
+ *                                    lo keeps q, r is sent to mid                  *
+ *                                                                                  *
+ * After log2(num_procs) levels every process holds the integer of its segment,     *
+ * converts it with its threads and writes it at its offset of the output file      *
+ * with collective MPI-IO. The segment is converted in chunks and every chunk is    *
+ * written with a non blocking collective call while the next one is converted.     *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * First digit of the segment of process proc_id
+ */
+long segment_start(long num_digits, int num_procs, int proc_id){
+    return (long) ((double) num_digits * proc_id / num_procs);
+}
+
+/*
+ * Writes the current chunk with a non blocking collective call, once the
+ * write of the previous one is done
+ */
+void write_chunk_MPI(segment_stream_t * stream){
+    MPI_Wait(&stream -> request, MPI_STATUS_IGNORE);
+    MPI_File_iwrite_at_all(stream -> file, stream -> offset, stream -> buffers[stream -> current], 
+                                (int) stream -> fill, MPI_CHAR, &stream -> request);
+    stream -> offset += stream -> fill;
+    stream -> rounds++;
+    stream -> current = 1 - stream -> current;
+    stream -> fill = 0;
+}
+
+/*
+ * Copies length chars to the chunks of the stream
+ */
+void stream_chars_MPI(segment_stream_t * stream, const char * chars, long length){
+    long count;
+
+    while (length > 0){
+        count = OUTPUT_CHUNK_CHARS - stream -> fill;
+        if (count > length) count = length;
+        memcpy(stream -> buffers[stream -> current] + stream -> fill, chars, count);
+        stream -> fill += count;
+        chars += count;
+        length -= count;
+        if (stream -> fill == OUTPUT_CHUNK_CHARS) write_chunk_MPI(stream);
+    }
+}
+
+/*
+ * Sink of the decimal conversion: writes the digits and the decimal point
+ */
+void stream_digits_MPI(const char * digits, long length, void * data){
+    long before_point;
+    segment_stream_t * stream = (segment_stream_t *) data;
+
+    before_point = stream -> point - stream -> digits;
+    if (before_point >= 0 && before_point < length){
+        stream_chars_MPI(stream, digits, before_point);
+        stream_chars_MPI(stream, ".", 1);
+        stream_chars_MPI(stream, digits + before_point, length - before_point);
+    } else {
+        stream_chars_MPI(stream, digits, length);
+    }
+    stream -> digits += length;
+}
+
+/*
+ * Writes pi with num_decimals decimals to file_name.
+ * Only process 0 needs pi, but all the processes must call it
+ */
+void write_decimals_MPI(int num_procs, int proc_id, const char * file_name, mpfr_t pi, 
+                            long num_decimals, int num_threads){
+    int lo, hi, mid, rounds, i, negative;
+    long info[2], num_digits, integer_digits, start, end, max_length, count;
+    mpz_t z, r, power;
+    segment_stream_t stream;
+
+    mpz_inits(z, r, power, NULL);
+    if (proc_id == 0){
+        info[0] = mpfr_get_scaled_decimals(z, pi, num_decimals, &negative);
+        info[1] = negative;
+    }
+    MPI_Bcast(info, 2, MPI_LONG, 0, MPI_COMM_WORLD);
+    integer_digits = info[0];
+    negative = info[1];
+    num_digits = integer_digits + num_decimals;
+
+    //Scatter the segments along the binary tree
+    lo = 0;
+    hi = num_procs;
+    while (hi - lo > 1){
+        mid = (lo + hi) / 2;
+        if (proc_id == lo){
+            mpz_ui_pow_ui(power, 10, segment_start(num_digits, num_procs, hi) - segment_start(num_digits, num_procs, mid));
+            mpz_tdiv_qr(z, r, z, power);
+            send_mpz(r, mid, 0);
+        } else if (proc_id == mid){
+            recv_mpz(z, lo, 0);
+        }
+        if (proc_id < mid) hi = mid;
+        else lo = mid;
+    }
+    mpz_clears(r, power, NULL);
+
+    //Every process writes the same number of chunks, the last ones may be empty
+    start = segment_start(num_digits, num_procs, proc_id);
+    end = segment_start(num_digits, num_procs, proc_id + 1);
+    max_length = 0;
+    for(i = 0; i < num_procs; i++){
+        count = segment_start(num_digits, num_procs, i + 1) - segment_start(num_digits, num_procs, i);
+        if (count > max_length) max_length = count;
+    }
+    rounds = (int) ((max_length + 2 + OUTPUT_CHUNK_CHARS - 1) / OUTPUT_CHUNK_CHARS);
+
+    if (MPI_File_open(MPI_COMM_WORLD, (char *) file_name, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, 
+                        &stream.file) != MPI_SUCCESS){
+        if (proc_id == 0) printf("  The decimals could not be written to %s \n\n", file_name);
+        MPI_Finalize();
+        exit(-1);
+    }
+    MPI_File_set_size(stream.file, 0);
+
+    //Offset of the segment: the sign and the decimal point are before it
+    stream.offset = start + negative;
+    if (start > integer_digits) stream.offset++;
+    if (proc_id == 0) stream.offset = 0;
+    stream.buffers[0] = malloc(OUTPUT_CHUNK_CHARS);
+    stream.buffers[1] = malloc(OUTPUT_CHUNK_CHARS);
+    stream.request = MPI_REQUEST_NULL;
+    stream.current = 0;
+    stream.rounds = 0;
+    stream.fill = 0;
+    stream.digits = 0;
+    stream.point = integer_digits - start;
+
+    //Convert and write the segment, with the sign and the decimal point if they fall in it
+    if (proc_id == 0 && negative) stream_chars_MPI(&stream, "-", 1);
+    mpz_stream_decimals(z, end - start, OUTPUT_CHUNK_CHARS, num_threads, stream_digits_MPI, &stream);
+    if (num_decimals == 0 && end == num_digits) stream_chars_MPI(&stream, ".", 1);
+    mpz_clear(z);
+    if (stream.fill > 0) write_chunk_MPI(&stream);
+    while (stream.rounds < rounds) write_chunk_MPI(&stream);
+    MPI_Wait(&stream.request, MPI_STATUS_IGNORE);
+    MPI_File_close(&stream.file);
+
+    //Clear memory
+    free(stream.buffers[0]);
+    free(stream.buffers[1]);
+}
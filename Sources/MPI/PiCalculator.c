@@ -7,10 +7,23 @@
 #include "../../Headers/MPI/Bellard_v1.h"
 #include "../../Headers/MPI/Bellard.h"
 #include "../../Headers/MPI/Chudnovsky_v2.h"
+#include "../../Headers/MPI/Chudnovsky_bs.h"
+#include "../../Headers/Sequential/Series_bs.h"
+#include "../../Headers/MPI/Series_bs.h"
+#include "../../Headers/Sequential/BBP_digits.h"
+#include "../../Headers/MPI/BBP_digits.h"
+#include "../../Headers/Sequential/Machin.h"
+#include "../../Headers/MPI/Machin.h"
+#include "../../Headers/Sequential/Fixed_point.h"
+#include "../../Headers/MPI/Fixed_point.h"
 #include "../../Headers/Common/Check_decimals.h"
-
-
-double gettimeofday();
+#include "../../Headers/Common/Check_hex_digits.h"
+#include "../../Headers/Common/Planner.h"
+#include "../../Headers/Common/Output.h"
+#include "../../Headers/Common/Manifest.h"
+#include "../../Headers/MPI/Output.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Report.h"
 
 
 void check_errors_MPI(int num_procs, int precision, int num_iterations, int num_threads, int proc_id, int algorithm){
@@ -29,73 +42,191 @@ void check_errors_MPI(int num_procs, int precision, int num_iterations, int num_
     }
 }
 
-void print_running_properties_MPI(int num_procs, int precision, int num_iterations, int num_threads){
+void print_running_properties_MPI(int num_procs, int precision, int num_iterations, int num_threads, plan_t * plan){
     printf("  Precision used: %d \n", precision);
     printf("  Iterations done: %d \n", num_iterations);
+    print_plan(plan);
     printf("  Number of processes: %d\n", num_procs);
     printf("  Number of threads (per process): %d\n", num_threads);
 }
 
+void calculate_hex_digits_MPI(int num_procs, int proc_id, int position, int num_threads){
+    double execution_time, run_started;
+    char hex[BBP_HEX_DIGITS + 1];
+
+    if (position < 0){
+        if(proc_id == 0) printf("  Position should not be negative. \n\n");
+        MPI_Finalize();
+        exit(-1);
+    }
+
+    //All the processes start the clock together
+    MPI_Barrier(MPI_COMM_WORLD);
+    run_started = phase_begin();
+    if (proc_id == 0){
+        printf("  Algorithm: BBP (Hexadecimal digit extraction) \n");
+        printf("  Position: %d \n", position);
+        printf("  Number of processes: %d\n", num_procs);
+        printf("  Number of threads (per process): %d\n", num_threads);
+    }
+    BBP_hex_digits_MPI(num_procs, proc_id, hex, position, num_threads);
+    if (proc_id == 0){
+        execution_time = phase_begin() - run_started;
+        printf("  Hex digits: %s \n", hex);
+        printf("  Execution time: %f seconds. \n", execution_time);
+        printf("\n");
+    }
+}
+
 void calculate_Pi_MPI(int num_procs, int proc_id, int algorithm, int precision, int num_threads){
-    double execution_time;
-    struct timeval t1, t2;
-    int num_iterations, decimals_computed, precision_bits; 
-    mpfr_t pi;    
-
-    //Get init time 
-    if(proc_id == 0){
-        gettimeofday(&t1, NULL);
+    double execution_time, run_started, started, hex_seconds, * seconds;
+    int num_iterations, decimals_computed, hex_matches, precision_bits, phase_values, manifest_error, * calls; 
+    mpfr_t pi;
+    plan_t plan;    
+
+    //BBP digit extraction does not compute pi, precision is the position of the digits
+    if (algorithm == 7){
+        calculate_hex_digits_MPI(num_procs, proc_id, precision, num_threads);
+        return;
     }
 
+    //A manifest that can not check the run is found out before computing it
+    if (get_manifest_file() != NULL){
+        manifest_error = (proc_id == 0) ? check_manifest_length(get_manifest_file(), precision) : 0;
+        MPI_Bcast(&manifest_error, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        if (manifest_error != 0){
+            MPI_Finalize();
+            exit(-1);
+        }
+    }
+
+    //Get init time, all the processes start the clock together
+    MPI_Barrier(MPI_COMM_WORLD);
+    run_started = phase_begin();
+
     //Set gmp float precision (in bits) and init pi
-    precision_bits = precision * 8;
+    plan_algorithm(algorithm, precision, &plan);
+    precision_bits = plan.precision_bits;
+    reset_phases(num_threads);
     mpfr_set_default_prec(precision_bits); 
     if (proc_id == 0){
         mpfr_init_set_ui(pi, 0, MPFR_RNDN);
     }
 
+    //The algorithms without timers of their own are all series
+    started = phase_begin();
     switch (algorithm)
     {
     case 0:
-        num_iterations = precision * 0.84;
+        num_iterations = plan.num_iterations;
         check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
         if (proc_id == 0){
             printf("  Algorithm: BBP (Last version)\n");
-            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads);
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
         } 
         BBP_algorithm_MPI(num_procs, proc_id, pi, num_iterations, num_threads, precision_bits);
         break;
 
     case 1:
-        num_iterations = precision / 3;
+        num_iterations = plan.num_iterations;
         check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
         if (proc_id == 0){
             printf("  Algorithm: Bellard (First version) \n");
-            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads);
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
         } 
         Bellard_algorithm_v1_MPI(num_procs, proc_id, pi, num_iterations, num_threads, precision_bits);
         break;
 
     case 2:
-        num_iterations = precision / 3;
+        num_iterations = plan.num_iterations;
         check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
         if (proc_id == 0){
             printf("  Algorithm: Bellard (Last version) \n");
-            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads);
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
         } 
         Bellard_algorithm_MPI(num_procs, proc_id, pi, num_iterations, num_threads, precision_bits);
         break;
 
     case 3:
-        num_iterations = (precision + 14 - 1) / 14;  //Division por exceso
+        num_iterations = plan.num_iterations;
         check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
         if (proc_id == 0){
             printf("  Algorithm: Chudnovsky (Without all factorials) \n");
-            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads);
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
         } 
         Chudnovsky_algorithm_v2_MPI(num_procs, proc_id, pi, num_iterations, num_threads, precision_bits);
         break;
 
+    case 4:
+        num_iterations = plan.num_iterations;
+        check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
+        if (proc_id == 0){
+            printf("  Algorithm: Chudnovsky (Binary splitting) \n");
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
+        } 
+        Chudnovsky_algorithm_bs_MPI(num_procs, proc_id, pi, num_iterations, num_threads, precision_bits);
+        break;
+
+    case 5:
+        num_iterations = plan.num_iterations;
+        check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
+        if (proc_id == 0){
+            printf("  Algorithm: BBP (Binary splitting) \n");
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
+        } 
+        Series_algorithm_bs_MPI(num_procs, proc_id, pi, &BBP_series, num_iterations, num_threads);
+        break;
+
+    case 6:
+        num_iterations = plan.num_iterations;
+        check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
+        if (proc_id == 0){
+            printf("  Algorithm: Bellard (Binary splitting) \n");
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
+        } 
+        Series_algorithm_bs_MPI(num_procs, proc_id, pi, &Bellard_series, num_iterations, num_threads);
+        break;
+
+    case 9:
+        num_iterations = Machin_iterations(&Takano_formula, precision);
+        check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
+        if (proc_id == 0){
+            printf("  Algorithm: Machin-like (Takano) \n");
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
+        } 
+        Machin_algorithm_MPI(num_procs, proc_id, pi, &Takano_formula, precision, num_threads, precision_bits);
+        break;
+
+    case 10:
+        num_iterations = Machin_iterations(&Stormer_formula, precision);
+        check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
+        if (proc_id == 0){
+            printf("  Algorithm: Machin-like (Stormer) \n");
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
+        } 
+        Machin_algorithm_MPI(num_procs, proc_id, pi, &Stormer_formula, precision, num_threads, precision_bits);
+        break;
+
+    case 11:
+        num_iterations = plan.num_iterations;
+        check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
+        if (proc_id == 0){
+            printf("  Algorithm: BBP (Fixed point) \n");
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
+        } 
+        Fixed_point_algorithm_MPI(num_procs, proc_id, pi, &BBP_fixed_series, num_iterations, num_threads, precision_bits);
+        break;
+
+    case 12:
+        num_iterations = plan.num_iterations;
+        check_errors_MPI(num_procs, precision, num_iterations, num_threads, proc_id, algorithm);
+        if (proc_id == 0){
+            printf("  Algorithm: Bellard (Fixed point) \n");
+            print_running_properties_MPI(num_procs, precision, num_iterations, num_threads, &plan);
+        } 
+        Fixed_point_algorithm_MPI(num_procs, proc_id, pi, &Bellard_fixed_series, num_iterations, num_threads, precision_bits);
+        break;
+
     default:
         if (proc_id == 0){
             printf("  Algorithm selected is not correct. Try with: \n");
@@ -103,21 +234,75 @@ void calculate_Pi_MPI(int num_procs, int proc_id, int algorithm, int precision,
             printf("      algorithm == 1 -> Bellard (First version) \n");
             printf("      algorithm == 2 -> Bellard (Last version) \n");
             printf("      algorithm == 3 -> Chudnovsky (Does not compute all factorials) \n");
+            printf("      algorithm == 4 -> Chudnovsky (Binary splitting) \n");
+            printf("      algorithm == 5 -> BBP (Binary splitting) \n");
+            printf("      algorithm == 6 -> Bellard (Binary splitting) \n");
+            printf("      algorithm == 7 -> BBP (Hex digits after position precision) \n");
+            printf("      algorithm == 9 -> Machin-like (Takano) \n");
+            printf("      algorithm == 10 -> Machin-like (Stormer) \n");
+            printf("      algorithm == 11 -> BBP (Fixed point) \n");
+            printf("      algorithm == 12 -> Bellard (Fixed point) \n");
             printf("\n");
         } 
         MPI_Finalize();
         exit(-1);
         break;
     }
+    if (!phase_recorded(PHASE_SERIES)) phase_end(PHASE_SERIES, 0, started);
 
-    //Get time, check decimals, free pi and print the results
+    //Get time, check decimals and print the results
     if (proc_id == 0) {  
-        gettimeofday(&t2, NULL);
-        execution_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
-        decimals_computed = check_decimals(pi);
-        mpfr_clear(pi);
-        printf("  Match the first %d decimals. \n", decimals_computed);
+        execution_time = phase_begin() - run_started;
+        if (get_manifest_file() != NULL){
+            decimals_computed = check_manifest(get_manifest_file(), pi, precision, num_threads);
+            printf("  Match the first %d decimals. \n", decimals_computed);
+        } else if (precision <= REFERENCE_DECIMALS){
+            decimals_computed = check_decimals(pi, num_threads);
+            printf("  Match the first %d decimals. \n", decimals_computed);
+            print_certified_decimals(&plan, decimals_computed);
+        } else if (get_hex_verification()){
+            //There is no reference for so many decimals, check some hex digits of the tail
+            decimals_computed = -1;
+            started = phase_begin();
+            hex_matches = check_hex_digits(pi, precision, num_threads);
+            hex_seconds = phase_begin() - started;
+            printf("  Hex spot checks passed: %d of %d (%f seconds, %.0f%% of the execution time). \n",
+                        hex_matches, HEX_SPOT_CHECKS, hex_seconds, 100 * hex_seconds / execution_time);
+        } else {
+            decimals_computed = -1;
+            printf("  There is no reference for so many decimals, check them with --verify=hex or --manifest=FILE. \n");
+        }
         printf("  Execution time: %f seconds. \n", execution_time);
+    }
+
+    //Write the decimals, the conversion is shared by all the processes
+    if (get_output_file() != NULL){
+        started = phase_begin();
+        write_decimals_MPI(num_procs, proc_id, get_output_file(), pi, precision, num_threads);
+        phase_end(PHASE_OUTPUT, 0, started);
+        if (proc_id == 0) printf("  Decimals written to %s. \n", get_output_file());
+    }
+
+    //Gather the phase times of all the processes, [process][phase][thread], and print the report
+    phase_values = NUM_PHASES * num_threads;
+    seconds = malloc(num_procs * phase_values * sizeof(double));
+    calls = malloc(num_procs * phase_values * sizeof(int));
+    get_phase_times(num_threads, seconds, calls);
+    MPI_Gather((proc_id == 0) ? MPI_IN_PLACE : seconds, phase_values, MPI_DOUBLE, 
+                seconds, phase_values, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    MPI_Gather((proc_id == 0) ? MPI_IN_PLACE : calls, phase_values, MPI_INT, 
+                calls, phase_values, MPI_INT, 0, MPI_COMM_WORLD);
+    if (proc_id == 0){
+        run_report_t run = {"MPI", algorithm, precision, num_iterations, num_threads, num_procs, 
+                                get_precision_tapering(), precision_bits, execution_time, decimals_computed};
+        print_report(&run, seconds, calls);
+    }
+    free(seconds);
+    free(calls);
+
+    //Free pi
+    if (proc_id == 0){
+        mpfr_clear(pi);
         printf("\n");
     }
 
@@ -1,14 +1,41 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <mpfr.h>
 #include "mpi.h"
 #include "../../Headers/MPI/PiCalculator.h"
 #include "../../Headers/Common/Print_title.h"
+#include "../../Headers/Common/Options.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Division_kernel.h"
+#include "../../Headers/Common/Output.h"
+#include "../../Headers/Common/Manifest.h"
+#include "../../Headers/Common/Check_hex_digits.h"
+#include "../../Headers/Common/Checkpoint.h"
+#include "../../Headers/Common/Report.h"
+#include "../../Headers/Common/Autoconfig.h"
 
 
 int incorrect_params(char* exec_name){
     printf("  Number of params are not correct. Try with:\n");
-    printf("    mpirun -np num_procs %s algorithm precision num_threads\n", exec_name);
+    printf("    mpirun -np num_procs %s algorithm precision num_threads [options]\n", exec_name);
+    printf("    mpirun -np num_procs %s auto precision [options]\n", exec_name);
     printf("\n");
+    print_options_usage();
+    printf("\n");
+}
+
+/*
+ * Processes of this run on the same host as this one
+ */
+int procs_on_host(){
+    int procs;
+    MPI_Comm host_comm;
+
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &host_comm);
+    MPI_Comm_size(host_comm, &procs);
+    MPI_Comm_free(&host_comm);
+    return procs;
 }
 
 int main(int argc, char **argv){    
@@ -19,6 +46,17 @@ int main(int argc, char **argv){
     MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
     MPI_Comm_rank(MPI_COMM_WORLD, &proc_id); 
 
+    //Check the number of parameters are correct, the report format decides where the title goes
+    options_t options;
+    int auto_mode = (argc >= 3 && strcmp(argv[1], "auto") == 0);
+    int first_option = (auto_mode) ? 3 : 4;
+    if(argc < first_option || parse_options(argc, argv, first_option, &options) != 0){
+        if(proc_id == 0) print_PiDecimals_title();
+        incorrect_params(argv[0]);
+        exit(-1);
+    }
+    set_report_format(options.report);
+
     //Print PiDecimals title 
     if(proc_id == 0){
         print_PiDecimals_title();
@@ -26,16 +64,37 @@ int main(int argc, char **argv){
         printf("\n");
     }
 
-    //Check the number of parameters are correct
-    if(argc != 4){
-        incorrect_params(argv[0]);
-        exit(-1);
+    //Take operation, precision and number of threads from params, or choose them with the profile
+    int algorithm, num_threads;
+    int precision = atoi(argv[2]);
+    if (auto_mode){
+        int choice[2], max_threads;
+        max_threads = host_cores() / procs_on_host();
+        if (max_threads < 1) max_threads = 1;
+        MPI_Allreduce(MPI_IN_PLACE, &max_threads, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+        if (proc_id == 0){
+            autoconfig_t config;
+            auto_configure(options.profile, AUTO_MPI, precision, num_procs, max_threads, 
+                            options.algorithm, options.threads, &config);
+            print_autoconfig(options.profile, &config);
+            printf("\n");
+            choice[0] = config.algorithm;
+            choice[1] = config.num_threads;
+        }
+        MPI_Bcast(choice, 2, MPI_INT, 0, MPI_COMM_WORLD);
+        algorithm = choice[0];
+        num_threads = choice[1];
+    } else {
+        algorithm = atoi(argv[1]);    
+        num_threads = (atoi(argv[3]) <= 0) ? 1 : atoi(argv[3]);
     }
 
-    //Take operation, precision and number of threads from params
-    int algorithm = atoi(argv[1]);    
-    int precision = atoi(argv[2]);
-    int num_threads = (atoi(argv[3]) <= 0) ? 1 : atoi(argv[3]);
+    set_precision_tapering(options.taper);
+    set_division_kernel(options.kernel);
+    set_output_file(options.output);
+    set_manifest_file(options.manifest);
+    set_checkpoint_file(options.checkpoint, options.resume);
+    set_hex_verification(options.verify_hex);
 
     //Compute Pi
     calculate_Pi_MPI(num_procs, proc_id, algorithm, precision, num_threads);
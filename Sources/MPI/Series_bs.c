@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "mpi.h"
+#include "../../Headers/Sequential/Series_bs.h"
+#include "../../Headers/MPI/OperationsMPI.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Report.h"
+
+
+/*
+ * Computes P, Q, B and T of a series for the range of terms [block_start, block_end)
+ * with threads. Each thread computes P, Q, B and T for a part of the range and 
+ * the results of the threads are merged in pairs. 
+ */
+void Series_bs_threads(const series_t * series, int block_start, int block_end, int num_threads,
+                                    mpz_t P_block, mpz_t Q_block, mpz_t B_block, mpz_t T_block){
+    int i, step;
+    mpz_t * P, * Q, * B, * T;
+
+    P = malloc(num_threads * sizeof(mpz_t));
+    Q = malloc(num_threads * sizeof(mpz_t));
+    B = malloc(num_threads * sizeof(mpz_t));
+    T = malloc(num_threads * sizeof(mpz_t));
+
+    //Set the number of threads 
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel 
+    {
+        int thread_id, thread_block_start, thread_block_end;
+        double started;
+
+        thread_id = omp_get_thread_num();
+        started = phase_begin();
+        even_block(block_start, block_end, num_threads, thread_id, &thread_block_start, &thread_block_end);
+
+        //First Phase -> Integers of the thread block (empty blocks are P = Q = B = 1, T = 0)
+        mpz_init_set_ui(P[thread_id], 1);
+        mpz_init_set_ui(Q[thread_id], 1);
+        mpz_init_set_ui(B[thread_id], 1);
+        mpz_init_set_ui(T[thread_id], 0);
+        if (thread_block_start < thread_block_end){
+            Series_bs(series, thread_block_start, thread_block_end, P[thread_id], Q[thread_id], B[thread_id], T[thread_id]);
+        }
+        phase_end(PHASE_SERIES, thread_id, started);
+    }
+
+    //Second Phase -> Merge the thread blocks in pairs
+    for(step = 1; step < num_threads; step *= 2){
+        #pragma omp parallel for
+            for(i = 0; i < num_threads - step; i += 2 * step){
+                double started = phase_begin();
+                Series_bs_merge(P[i], Q[i], B[i], T[i], P[i + step], Q[i + step], B[i + step], T[i + step]);
+                phase_end(PHASE_THREAD_REDUCTION, omp_get_thread_num(), started);
+            }
+    }
+    mpz_swap(P_block, P[0]);
+    mpz_swap(Q_block, Q[0]);
+    mpz_swap(B_block, B[0]);
+    mpz_swap(T_block, T[0]);
+
+    //Clear memory
+    for(i = 0; i < num_threads; i++){
+        mpz_clears(P[i], Q[i], B[i], T[i], NULL);
+    }
+    free(P);
+    free(Q);
+    free(B);
+    free(T);
+}
+
+/*
+ * Parallel evaluation of the first num_iterations terms of a series
+ * with binary splitting. 
+ * The number of iterations is divided by blocks, so each process 
+ * computes the exact P, Q, B and T integers of its block using threads
+ * (Series_bs_threads).
+ * Finally, the results of the processes are merged through a tree 
+ * of sends and receives, so the process 0 gets the integers of all 
+ * the terms and computes the result with a single division.
+ */
+void Series_algorithm_bs_MPI(int num_procs, int proc_id, mpfr_t result, const series_t * series,
+                                    int num_iterations, int num_threads){
+    int block_start, block_end, step;
+    double started;
+    mpz_t P, Q, B, T, P2, Q2, B2, T2;
+
+    even_block(0, num_iterations, num_procs, proc_id, &block_start, &block_end);
+
+    mpz_inits(P, Q, B, T, P2, Q2, B2, T2, NULL);
+    Series_bs_threads(series, block_start, block_end, num_threads, P, Q, B, T);
+
+    //Merge the process blocks through a tree of communications
+    started = phase_begin();
+    for(step = 1; step < num_procs; step *= 2){
+        if (proc_id % (2 * step) != 0){
+            send_mpz(P, proc_id - step, 0);
+            send_mpz(Q, proc_id - step, 1);
+            send_mpz(B, proc_id - step, 2);
+            send_mpz(T, proc_id - step, 3);
+            break;
+        } 
+        if (proc_id + step < num_procs){
+            recv_mpz(P2, proc_id + step, 0);
+            recv_mpz(Q2, proc_id + step, 1);
+            recv_mpz(B2, proc_id + step, 2);
+            recv_mpz(T2, proc_id + step, 3);
+            Series_bs_merge(P, Q, B, T, P2, Q2, B2, T2);
+        }
+    }
+    phase_end(PHASE_MPI_REDUCTION, 0, started);
+
+    //Process 0 does the last operation
+    if (proc_id == 0){
+        started = phase_begin();
+        Series_bs_value(result, Q, B, T);
+        phase_end(PHASE_FINAL, 0, started);
+    }
+
+    //Clear memory
+    mpz_clears(P, Q, B, T, P2, Q2, B2, T2, NULL);
+}
@@ -3,6 +3,10 @@
 #include <mpfr.h>
 #include <omp.h>
 #include "../../Headers/Sequential/BBP.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Checkpoint.h"
+#include "../../Headers/Common/Scheduler.h"
+#include "../../Headers/Common/Report.h"
 
 #define QUOTIENT 0.0625
 
@@ -10,53 +14,85 @@
 /*
  * Parallel Pi number calculation using the BBP algorithm
  * Multiple threads can be used
- * The number of iterations is divided in blocks, 
- * so each thread calculates a part of Pi.  
+ * The number of iterations is divided in chunks (blocks of the same cost 
+ * with tapering) and each thread starts with a contiguous range of them.
+ * Idle threads steal the chunks left by the others and seed dep_m again
+ * at the start of the stolen ones.
+ * With a checkpoint file, the chunks of a resumed run are the ones of the
+ * checkpoint, whatever the number of threads.
  */
 
 void BBP_algorithm_OMP(mpfr_t pi, int num_iterations, int num_threads, int precision_bits){
+    checkpoint_t checkpoint;
+    schedule_t schedule;
     mpfr_t quotient; 
 
     mpfr_init_set_d(quotient, QUOTIENT, MPFR_RNDN);         // quotient = (1 / 16)   
 
+    calibrate_cost_model(BBP_probe, precision_bits);
+    checkpoint_begin(&checkpoint, CHECKPOINT_BBP, num_iterations, schedule_chunks(num_iterations, num_threads), 
+                        precision_bits, BBP_BITS_PER_TERM, 2, 1);
+    checkpoint_start(&checkpoint, 0, checkpoint.num_units);
+    schedule_init(&schedule, checkpoint.num_units, num_threads);
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {
-        int thread_id, i, block_size, block_start, block_end;
+        int thread_id, unit, i, block_start, block_end, state_next;
+        long working_precision;
+        double started;
         mpfr_t local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux;
 
         thread_id = omp_get_thread_num();
-        block_size = (num_iterations + num_threads - 1) / num_threads;
-        block_start = thread_id * block_size;
-        block_end = block_start + block_size;
-        if (block_end > num_iterations) block_end = num_iterations;
-        
-        mpfr_init2(local_pi, precision_bits);               // private thread pi
-        mpfr_set_ui(local_pi, 0, MPFR_RNDN);
-        mpfr_init2(dep_m, precision_bits);
-        mpfr_pow_ui(dep_m, quotient, block_start, MPFR_RNDN);    // m = (1/16)^n                  
-        mpfr_inits2(precision_bits, quot_a, quot_b, quot_c, quot_d, aux, NULL);
-        
+        phase_add(PHASE_SERIES, thread_id, 0);
+        state_next = -1;                                    // Iteration of dep_m
+        mpfr_inits2(precision_bits, local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux, NULL);
 
-        //First Phase -> Working on a local variable        
-        #pragma omp parallel for 
-            for(i = block_start; i < block_end; i++){
-                BBP_iteration(local_pi, i, dep_m, quot_a, quot_b, quot_c, quot_d, aux);
-                // Update dependencies:  
-                mpfr_mul(dep_m, dep_m, quotient, MPFR_RNDN);
+        while ((unit = schedule_next(&schedule, thread_id)) >= 0){
+            started = phase_begin();
+            block_start = checkpoint_restore(&checkpoint, unit, local_pi, dep_m, NULL);
+            block_end = checkpoint.units[unit].end;
+            if (block_start < 0){
+                block_start = checkpoint.units[unit].start;
+                set_term_precision(precision_bits, local_pi, NULL);
+                mpfr_set_ui(local_pi, 0, MPFR_RNDN);                // private chunk pi
+                if (block_start != state_next){
+                    set_term_precision(precision_bits, dep_m, NULL);
+                    mpfr_set_ui_2exp(dep_m, 1, -4L * block_start, MPFR_RNDN);    // m = (1/16)^n
+                }
             }
 
-        //Second Phase -> Accumulate the result in the global variable
-        #pragma omp critical
-        mpfr_add(pi, pi, local_pi, MPFR_RNDN);
+            //First Phase -> Working on a local variable        
+            #pragma omp parallel for 
+                for(i = block_start; i < block_end; i++){
+                    working_precision = term_precision(precision_bits, i, BBP_BITS_PER_TERM);
+                    set_term_precision(working_precision, quot_a, quot_b, quot_c, quot_d, aux, NULL);
+                    round_term_precision(working_precision, dep_m, NULL);
+                    BBP_iteration(local_pi, i, dep_m, quot_a, quot_b, quot_c, quot_d, aux);
+                    // Update dependencies:  
+                    mpfr_mul(dep_m, dep_m, quotient, MPFR_RNDN);
+                    checkpoint_save(&checkpoint, unit, i + 1, local_pi, dep_m, NULL);
+                }
+            state_next = block_end;
+            phase_end(PHASE_SERIES, thread_id, started);
 
+            //Second Phase -> Accumulate the result in the global variable
+            started = phase_begin();
+            #pragma omp critical
+            mpfr_add(pi, pi, local_pi, MPFR_RNDN);
+            phase_end(PHASE_THREAD_REDUCTION, thread_id, started);
+        }
 
         //Clear thread memory
         mpfr_free_cache();
         mpfr_clears(local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux, NULL);   
     }
+
+    schedule_clear(&schedule);
+    checkpoint_end(&checkpoint);
+    checkpoint_remove(&checkpoint);
         
     //Clear memory
     mpfr_clear(quotient);
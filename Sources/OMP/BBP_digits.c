@@ -0,0 +1,41 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include "../../Headers/Sequential/BBP_digits.h"
+
+
+/*
+ * Parallel computation of the hex digits of pi after position
+ * Multiple threads can be used
+ * The range of k is divided in blocks, so each thread 
+ * computes the fractional part of a part of the sum.  
+ */
+void BBP_hex_digits_OMP(char * hex, long position, int num_threads){
+    long num_terms;
+    long double sum;
+
+    num_terms = position + 1 + BBP_TAIL_TERMS;
+    sum = 0;
+
+    //Set the number of threads 
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel reduction(+:sum)
+    {
+        int thread_id;
+        long block_size, block_start, block_end;
+
+        thread_id = omp_get_thread_num();
+        block_size = (num_terms + num_threads - 1) / num_threads;
+        block_start = thread_id * block_size;
+        block_end = block_start + block_size;
+        if (block_end > num_terms) block_end = num_terms;
+
+        if (block_start < block_end){
+            sum += BBP_digits_partial(position, block_start, block_end);
+        }
+    }
+
+    BBP_fraction_to_hex(hex, sum);
+}
@@ -3,80 +3,91 @@
 #include <mpfr.h>
 #include <omp.h>
 #include "../../Headers/Sequential/Bellard_v1.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Scheduler.h"
+#include "../../Headers/Common/Report.h"
 
 
 
 /*
  * Parallel Pi number calculation using the Bellard algorithm
  * Multiple threads can be used
- * The number of iterations is divided cyclically, 
- * so each thread calculates a part of Pi.  
+ * The number of iterations is divided in chunks (blocks of the same cost 
+ * with tapering) and each thread starts with a contiguous range of them.
+ * Idle threads steal the chunks left by the others and seed dep_m again
+ * at the start of the stolen ones.
  */
 void Bellard_algorithm_v1_OMP(mpfr_t pi, int num_iterations, int num_threads, int precision_bits){
-    mpfr_t jump; 
+    int num_chunks;
+    schedule_t schedule;
+    double started;
 
-    mpfr_init2(jump, precision_bits);
-    mpfr_set_ui(jump, 1, MPFR_RNDN); 
-    mpfr_div_ui(jump, jump, 1024, MPFR_RNDN);
-    mpfr_pow_ui(jump, jump, num_threads, MPFR_RNDN);
+    calibrate_cost_model(Bellard_v1_probe, precision_bits);
+    num_chunks = schedule_chunks(num_iterations, num_threads);
+    schedule_init(&schedule, num_chunks, num_threads);
 
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {
-        int thread_id, i, dep_a, dep_b, jump_dep_a, jump_dep_b;
+        int thread_id, chunk, i, block_start, block_end, state_next, dep_a, dep_b;
+        long working_precision;
+        double started;
         mpfr_t local_pi, dep_m, a, b, c, d, e, f, g, aux;
 
         thread_id = omp_get_thread_num();
+        phase_add(PHASE_SERIES, thread_id, 0);
+        state_next = -1;                                    // Iteration of dep_m
 
         mpfr_init2(local_pi, precision_bits);               // private thread pi
         mpfr_set_ui(local_pi, 0, MPFR_RNDN);
-        dep_a = thread_id * 4;
-        dep_b = thread_id * 10;
-        jump_dep_a = 4 * num_threads;
-        jump_dep_b = 10 * num_threads;
         mpfr_init2(dep_m, precision_bits);
-        mpfr_set_ui(dep_m, 1, MPFR_RNDN);
-        mpfr_div_ui(dep_m, dep_m, 1024, MPFR_RNDN);
-        mpfr_pow_ui(dep_m, dep_m, thread_id, MPFR_RNDN);        // dep_m = ((-1)^n)/1024)
-        if(thread_id % 2 != 0) mpfr_neg(dep_m, dep_m, MPFR_RNDN);                   
         mpfr_inits2(precision_bits, a, b, c, d, e, f, g, aux, NULL);
 
-        //First Phase -> Working on a local variable
-        if(num_threads % 2 != 0){
+        while ((chunk = schedule_next(&schedule, thread_id)) >= 0){
+            started = phase_begin();
+            taper_block(0, num_iterations, num_chunks, chunk, precision_bits, BELLARD_BITS_PER_TERM, 
+                            &block_start, &block_end);
+            dep_a = block_start * 4;
+            dep_b = block_start * 10;
+            if (block_start != state_next){
+                set_term_precision(precision_bits, dep_m, NULL);
+                mpfr_set_si_2exp(dep_m, (block_start % 2 != 0) ? -1 : 1, -10L * block_start, MPFR_RNDN);
+            }                                               // dep_m = ((-1)^n)/1024^n)
+
+            //First Phase -> Working on a local variable
             #pragma omp parallel for 
-                for(i = thread_id; i < num_iterations; i+=num_threads){
+                for(i = block_start; i < block_end; i++){
+                    working_precision = term_precision(precision_bits, i, BELLARD_BITS_PER_TERM);
+                    set_term_precision(working_precision, a, b, c, d, e, f, g, aux, NULL);
+                    round_term_precision(working_precision, dep_m, NULL);
                     Bellard_iteration_v1(local_pi, i, dep_m, a, b, c, d, e, f, g, aux, dep_a, dep_b);
                     // Update dependencies for next iteration:
-                    mpfr_mul(dep_m, dep_m, jump, MPFR_RNDN); 
+                    mpfr_div_2ui(dep_m, dep_m, 10, MPFR_RNDN); 
                     mpfr_neg(dep_m, dep_m, MPFR_RNDN); 
-                    dep_a += jump_dep_a;
-                    dep_b += jump_dep_b;  
-                }
-        } else {
-            #pragma omp parallel for
-                for(i = thread_id; i < num_iterations; i+=num_threads){
-                    Bellard_iteration_v1(local_pi, i, dep_m, a, b, c, d, e, f, g, aux, dep_a, dep_b);
-                    // Update dependencies for next iteration:
-                    mpfr_mul(dep_m, dep_m, jump, MPFR_RNDN);    
-                    dep_a += jump_dep_a;
-                    dep_b += jump_dep_b;  
+                    dep_a += 4;
+                    dep_b += 10;  
                 }
+            state_next = block_end;
+            phase_end(PHASE_SERIES, thread_id, started);
         }
 
         //Second Phase -> Accumulate the result in the global variable
+        started = phase_begin();
         #pragma omp critical
         mpfr_add(pi, pi, local_pi, MPFR_RNDN);
+        phase_end(PHASE_THREAD_REDUCTION, thread_id, started);
 
         //Clear thread memory
         mpfr_free_cache();
         mpfr_clears(local_pi, dep_m, a, b, c, d, e, f, g, aux, NULL);   
     }
 
+    schedule_clear(&schedule);
+
+    started = phase_begin();
     mpfr_div_ui(pi, pi, 64, MPFR_RNDN);
-        
-    //Clear memory
-    mpfr_clear(jump);
+    phase_end(PHASE_FINAL, 0, started);
 }
 
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "../../Headers/Sequential/Chudnovsky_bs.h"
+#include "../../Headers/Common/Report.h"
+
+#define D 426880
+#define E 10005
+#define MIN_TASK_TERMS 64           // Ranges with less terms are not split in tasks
+#define MIN_SPLIT_MUL_LIMBS 2048    // Smaller products are not split among threads
+
+
+/*
+ * Multiplies x and y using up to pieces threads, with Karatsuba steps whose
+ * half size products are tasks:
+ *
+ *      x = x1 2^h + x0,  y = y1 2^h + y0
+ *      x y = z2 2^2h + ((x1 + x0)(y1 + y0) - z2 - z0) 2^h + z0,  z2 = x1 y1, z0 = x0 y0
+ *
+ * The 3 products cost little more than x y, while splitting only one operand in
+ * n pieces multiplies all of the other one n times. If an operand is less than
+ * half of the other one, only the greatest one is split in two halves.
+ */
+void mpz_mul_OMP(mpz_t r, mpz_t x, mpz_t y, int pieces){
+    mp_bitcnt_t half;
+    mpz_t x0, x1, x_sum, y0, y1, y_sum, z0, z1, z2;
+
+    if (mpz_size(x) > mpz_size(y)){
+        mpz_ptr swap = x; x = y; y = swap;
+    }
+    if (pieces < 2 || mpz_size(x) < MIN_SPLIT_MUL_LIMBS){
+        mpz_mul(r, x, y);
+        return;
+    }
+
+    half = mpz_sizeinbase(y, 2) / 2;
+    mpz_inits(y0, y1, z0, z2, NULL);
+    mpz_fdiv_q_2exp(y1, y, half);
+    mpz_fdiv_r_2exp(y0, y, half);
+    if (mpz_sizeinbase(x, 2) <= half){
+        #pragma omp task shared(z2, x, y1)
+        mpz_mul_OMP(z2, x, y1, pieces / 2);
+        mpz_mul_OMP(z0, x, y0, pieces / 2);
+        #pragma omp taskwait
+
+        mpz_mul_2exp(r, z2, half);
+        mpz_add(r, r, z0);
+        mpz_clears(y0, y1, z0, z2, NULL);
+        return;
+    }
+
+    mpz_inits(x0, x1, x_sum, y_sum, z1, NULL);
+    mpz_fdiv_q_2exp(x1, x, half);
+    mpz_fdiv_r_2exp(x0, x, half);
+    mpz_add(x_sum, x1, x0);
+    mpz_add(y_sum, y1, y0);
+    #pragma omp task shared(z2, x1, y1)
+    mpz_mul_OMP(z2, x1, y1, pieces / 3);
+    #pragma omp task shared(z0, x0, y0)
+    mpz_mul_OMP(z0, x0, y0, pieces / 3);
+    mpz_mul_OMP(z1, x_sum, y_sum, pieces / 3);
+    #pragma omp taskwait
+
+    mpz_sub(z1, z1, z2);
+    mpz_sub(z1, z1, z0);
+    mpz_mul_2exp(r, z2, 2 * half);
+    mpz_mul_2exp(z1, z1, half);
+    mpz_add(r, r, z1);
+    mpz_add(r, r, z0);
+    mpz_clears(x0, x1, x_sum, y0, y1, y_sum, z0, z1, z2, NULL);
+}
+
+/*
+ * Computes P, Q and T for the range of terms [a, b) with omp tasks.
+ * threads is the number of threads that are expected to work on this range,
+ * it is used for splitting the products of the merge between them.
+ * P is not computed if need_P is zero (right-most ranges never need it).
+ */
+void Chudnovsky_bs_OMP(int a, int b, mpz_t P, mpz_t Q, mpz_t T, int threads, int grain, int need_P){
+    int m, pieces;
+    mpz_t P2, Q2, T2;
+
+    if (b - a <= grain){
+        double started = phase_begin();
+        Chudnovsky_bs(a, b, P, Q, T);
+        phase_end(PHASE_SERIES, omp_get_thread_num(), started);
+        return;
+    }
+
+    m = a + (b - a) / 2;
+    mpz_inits(P2, Q2, T2, NULL);
+
+    #pragma omp task shared(P, Q, T)
+    Chudnovsky_bs_OMP(a, m, P, Q, T, (threads + 1) / 2, grain, 1);
+    #pragma omp task shared(P2, Q2, T2)
+    Chudnovsky_bs_OMP(m, b, P2, Q2, T2, (threads + 1) / 2, grain, need_P);
+    #pragma omp taskwait
+
+    //Merge: the products that read P are done before P is updated
+    pieces = threads / 4;
+    #pragma omp task shared(T, Q2)
+    mpz_mul_OMP(T, T, Q2, pieces);              // T = Q2 T
+    #pragma omp task shared(T2, P)
+    mpz_mul_OMP(T2, T2, P, pieces);             // T2 = P T2
+    #pragma omp task shared(Q, Q2)
+    mpz_mul_OMP(Q, Q, Q2, pieces);              // Q = Q Q2
+    #pragma omp taskwait
+    if (need_P){
+        #pragma omp task shared(P, P2)
+        mpz_mul_OMP(P, P, P2, 2 * pieces);      // P = P P2
+    }
+    mpz_add(T, T, T2);                          // T = Q2 T + P T2
+    #pragma omp taskwait
+
+    mpz_clears(P2, Q2, T2, NULL);
+}
+
+/*
+ * Parallel Pi number calculation using the Chudnovsky algorithm
+ * with binary splitting. Multiple threads can be used.
+ * The recursion tree is turned into omp tasks,
+ * and the products of the top merges are also split among threads.
+ * The square root is computed while the series is being evaluated.
+ */
+void Chudnovsky_algorithm_bs_OMP(mpfr_t pi, int num_iterations, int num_threads, int precision_bits){
+    int grain;
+    double started;
+    mpz_t P, Q, T;
+    mpfr_t e, aux;
+
+    mpz_inits(P, Q, T, NULL);
+    mpfr_inits2(precision_bits, e, aux, NULL);
+
+    //Each thread will get around 8 leaf tasks
+    grain = num_iterations / (8 * num_threads);
+    if (grain < MIN_TASK_TERMS) grain = MIN_TASK_TERMS;
+
+    //Set the number of threads
+    omp_set_num_threads(num_threads);
+
+    //The leaves of the task tree are the series, the rest of the tree are the merges
+    started = phase_begin();
+    #pragma omp parallel
+    #pragma omp single
+    {
+        #pragma omp task shared(e)
+        {
+            mpfr_sqrt_ui(e, E, MPFR_RNDN);
+            mpfr_mul_ui(e, e, D, MPFR_RNDN);
+        }
+        Chudnovsky_bs_OMP(0, num_iterations, P, Q, T, num_threads, grain, 0);
+        #pragma omp taskwait
+    }
+    phase_add_rest(PHASE_THREAD_REDUCTION, PHASE_SERIES, phase_begin() - started);
+
+    started = phase_begin();
+    mpfr_mul_z(e, e, Q, MPFR_RNDN);
+    mpfr_set_z(aux, T, MPFR_RNDN);
+    mpfr_div(pi, e, aux, MPFR_RNDN);
+    phase_end(PHASE_FINAL, 0, started);
+
+    //Clear memory
+    mpz_clears(P, Q, T, NULL);
+    mpfr_clears(e, aux, NULL);
+}
@@ -3,7 +3,11 @@
 #include <gmp.h>
 #include <mpfr.h>
 #include <omp.h>
-#include "../../Headers/Sequential/Chudnovsky.h"
+#include "../../Headers/Sequential/Chudnovsky_v2.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Checkpoint.h"
+#include "../../Headers/Common/Scheduler.h"
+#include "../../Headers/Common/Report.h"
 
 
 #define A 13591409
@@ -13,39 +17,23 @@
 #define E 10005
 
 
-/*
- * This method is used by ParallelChudnovskyAlgorithm threads
- * for computing the first value of dep_a
- */
-void init_dep_a(mpfr_t dep_a, int block_start, int precision_bits){
-    mpz_t factorial_n, dividend, divisor;
-    mpfr_t float_dividend, float_divisor;
-    mpz_inits(factorial_n, dividend, divisor, NULL);
-    mpfr_inits2(precision_bits ,float_dividend, float_divisor, NULL);
-
-    mpz_fac_ui(factorial_n, block_start);
-    mpz_fac_ui(divisor, 3 * block_start);
-    mpz_fac_ui(dividend, 6 * block_start);
-
-    mpz_pow_ui(factorial_n, factorial_n, 3);
-    mpz_mul(divisor, divisor, factorial_n);
-
-    mpfr_set_z(float_dividend, dividend, MPFR_RNDN);
-    mpfr_set_z(float_divisor, divisor, MPFR_RNDN);
-
-    mpfr_div(dep_a, float_dividend, float_divisor, MPFR_RNDN);
-
-    mpz_clears(factorial_n, dividend, divisor, NULL);
-    mpfr_clears(float_dividend, float_divisor, NULL);
-}
-
 /*
  * Parallel Pi number calculation using the Chudnovsky algorithm
  * Multiple threads can be used
- * The number of iterations is divided by blocks 
- * so each thread calculates a part of pi.  
+ * The number of iterations is divided in chunks (blocks of the same cost 
+ * with tapering) and each thread starts with a contiguous range of them.
+ * Idle threads steal the chunks left by the others and take the
+ * dependencies at the start of the stolen ones from the seeds, which
+ * are computed for all the chunks in one pass.
+ * With a checkpoint file, the chunks of a resumed run are the ones of the
+ * checkpoint, whatever the number of threads.
  */
 void Chudnovsky_algorithm_v2_OMP(mpfr_t pi, int num_iterations, int num_threads, int precision_bits){
+    checkpoint_t checkpoint;
+    schedule_t schedule;
+    Chudnovsky_seeds_t seeds;
+    int thread, * first_units;
+    double started;
     mpfr_t e, c;
 
     mpfr_inits2(precision_bits, e, c, NULL);
@@ -54,63 +42,89 @@ void Chudnovsky_algorithm_v2_OMP(mpfr_t pi, int num_iterations, int num_threads,
     mpfr_neg(c, c, MPFR_RNDN);
     mpfr_pow_ui(c, c, 3, MPFR_RNDN);
 
+    calibrate_cost_model(Chudnovsky_probe, precision_bits);
+    checkpoint_begin(&checkpoint, CHECKPOINT_CHUDNOVSKY, num_iterations, schedule_chunks(num_iterations, num_threads), 
+                        precision_bits, CHUDNOVSKY_BITS_PER_TERM, 4, 1);
+    checkpoint_start(&checkpoint, 0, checkpoint.num_units);
+    schedule_init(&schedule, checkpoint.num_units, num_threads);
+
+    //Only the first unit of every thread is seeded, the stolen ones are seeded when they are taken
+    started = phase_begin();
+    first_units = malloc(num_threads * sizeof(int));
+    for(thread = 0; thread < num_threads; thread++) first_units[thread] = schedule.threads[thread].next;
+    init_Chudnovsky_seeds(&seeds, &checkpoint, first_units, num_threads, precision_bits, num_threads);
+    free(first_units);
+    phase_end(PHASE_SEEDING, 0, started);
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {   
-        int thread_id, i, block_size, block_start, block_end, factor_a, * distribution;
+        int thread_id, unit, i, block_start, block_end, state_next;
+        long working_precision;
+        double started;
         mpfr_t local_pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux;
 
         thread_id = omp_get_thread_num();
-        
-        block_size = (num_iterations + num_threads - 1) / num_threads;
-        block_start = thread_id * block_size;
-        block_end = block_start + block_size;
-        if (block_end > num_iterations) block_end = num_iterations;
-        
+        phase_add(PHASE_SERIES, thread_id, 0);
+        state_next = -1;                                    // Iteration of the dependencies
         mpfr_inits2(precision_bits, local_pi, dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);
-        mpfr_set_ui(local_pi, 0, MPFR_RNDN);    // private thread pi
-        init_dep_a(dep_a, block_start, precision_bits);
-        mpfr_pow_ui(dep_b, c, block_start, MPFR_RNDN);
-        mpfr_set_ui(dep_c, B, MPFR_RNDN);
-        mpfr_mul_ui(dep_c, dep_c, block_start, MPFR_RNDN);
-        mpfr_add_ui(dep_c, dep_c, A, MPFR_RNDN);
-        factor_a = 12 * block_start;
-
-        //First Phase -> Working on a local variable        
-        #pragma omp parallel for 
-            for(i = block_start; i < block_end; i++){
-                Chudnovsky_iteration(local_pi, i, dep_a, dep_b, dep_c, aux);
-                //Update dep_a:
-                mpfr_set_ui(dep_a_dividend, factor_a + 10, MPFR_RNDN);
-                mpfr_mul_ui(dep_a_dividend, dep_a_dividend, factor_a + 6, MPFR_RNDN);
-                mpfr_mul_ui(dep_a_dividend, dep_a_dividend, factor_a + 2, MPFR_RNDN);
-                mpfr_mul(dep_a_dividend, dep_a_dividend, dep_a, MPFR_RNDN);
-
-                mpfr_set_ui(dep_a_divisor, i + 1, MPFR_RNDN);
-                mpfr_pow_ui(dep_a_divisor, dep_a_divisor , 3, MPFR_RNDN);
-                mpfr_div(dep_a, dep_a_dividend, dep_a_divisor, MPFR_RNDN);
-                factor_a += 12;
-
-                //Update dep_b:
-                mpfr_mul(dep_b, dep_b, c, MPFR_RNDN);
-
-                //Update dep_c:
-                mpfr_add_ui(dep_c, dep_c, B, MPFR_RNDN);
+
+        while ((unit = schedule_next(&schedule, thread_id)) >= 0){
+            started = phase_begin();
+            block_start = checkpoint_restore(&checkpoint, unit, local_pi, dep_a, dep_b, dep_c, NULL);
+            block_end = checkpoint.units[unit].end;
+            if (block_start < 0){
+                block_start = checkpoint.units[unit].start;
+                set_term_precision(precision_bits, local_pi, NULL);
+                mpfr_set_ui(local_pi, 0, MPFR_RNDN);    // private chunk pi
+                if (block_start != state_next){
+                    set_Chudnovsky_seed(&seeds, &checkpoint, unit, precision_bits, dep_a, dep_b, dep_c);
+                }
             }
 
-        //Second Phase -> Accumulate the result in the global variable 
-        #pragma omp critical
-        mpfr_add(pi, pi, local_pi, MPFR_RNDN);
+            //First Phase -> Working on a local variable        
+            #pragma omp parallel for 
+                for(i = block_start; i < block_end; i++){
+                    working_precision = term_precision(precision_bits, i, CHUDNOVSKY_BITS_PER_TERM);
+                    set_term_precision(working_precision, dep_a_dividend, dep_a_divisor, aux, NULL);
+                    round_term_precision(working_precision, dep_a, dep_b, dep_c, NULL);
+                    Chudnovsky_iteration(local_pi, i, dep_a, dep_b, dep_c, aux);
+                    //Update dep_a:
+                    Chudnovsky_update_a(dep_a, i, dep_a_dividend, dep_a_divisor);
+
+                    //Update dep_b:
+                    mpfr_mul(dep_b, dep_b, c, MPFR_RNDN);
+
+                    //Update dep_c:
+                    mpfr_add_ui(dep_c, dep_c, B, MPFR_RNDN);
+                    checkpoint_save(&checkpoint, unit, i + 1, local_pi, dep_a, dep_b, dep_c, NULL);
+                }
+            state_next = block_end;
+            phase_end(PHASE_SERIES, thread_id, started);
+
+            //Second Phase -> Accumulate the result in the global variable 
+            started = phase_begin();
+            #pragma omp critical
+            mpfr_add(pi, pi, local_pi, MPFR_RNDN);
+            phase_end(PHASE_THREAD_REDUCTION, thread_id, started);
+        }
         
         //Clear thread memory
         mpfr_clears(local_pi, dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);   
     }
 
+    schedule_clear(&schedule);
+    clear_Chudnovsky_seeds(&seeds);
+    checkpoint_end(&checkpoint);
+    checkpoint_remove(&checkpoint);
+
+    started = phase_begin();
     mpfr_sqrt(e, e, MPFR_RNDN);
     mpfr_mul_ui(e, e, D, MPFR_RNDN);
     mpfr_div(pi, e, pi, MPFR_RNDN);    
+    phase_end(PHASE_FINAL, 0, started);
     
     //Clear memory
     mpfr_clears(c, e, NULL);
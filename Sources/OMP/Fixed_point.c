@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "../../Headers/Sequential/Fixed_point.h"
+#include "../../Headers/Common/Report.h"
+
+
+/*
+ * Parallel Pi number calculation with a fixed point series
+ * Multiple threads can be used
+ * The cost of a term decreases with n, so the iterations are cyclically
+ * divided among the threads to keep them balanced.
+ * Each thread adds its terms in a private fixed point sum and
+ * the sums of the threads are added at the end.
+ */
+void Fixed_point_algorithm_OMP(mpfr_t pi, const fixed_series_t * series, int num_iterations,
+                                    int num_threads, int precision_bits){
+    double started;
+    mp_size_t size;
+    mp_ptr sum;
+
+    size = Fixed_point_size(precision_bits);
+    sum = calloc(size, sizeof(mp_limb_t));
+
+    //Set the number of threads
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel
+    {
+        int thread_id;
+        double started;
+        mp_ptr local_sum;
+
+        thread_id = omp_get_thread_num();
+        started = phase_begin();
+        local_sum = calloc(size, sizeof(mp_limb_t));             // private thread sum
+
+        //First Phase -> Working on a local variable
+        Fixed_point_sum(local_sum, size, series, thread_id, num_iterations, num_threads);
+        phase_end(PHASE_SERIES, thread_id, started);
+
+        //Second Phase -> Accumulate the result in the global variable
+        started = phase_begin();
+        #pragma omp critical
+        mpn_add_n(sum, sum, local_sum, size);
+        phase_end(PHASE_THREAD_REDUCTION, thread_id, started);
+
+        //Clear thread memory
+        free(local_sum);
+    }
+
+    started = phase_begin();
+    Fixed_point_to_mpfr(pi, sum, size);
+    phase_end(PHASE_FINAL, 0, started);
+
+    //Clear memory
+    free(sum);
+}
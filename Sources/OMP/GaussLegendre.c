@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "../../Headers/OMP/Chudnovsky_bs.h"
+
+#define MIN_SPLIT_SQRT_BITS 65536   // Smaller square roots are done by mpfr
+#define SQRT_START_BITS 256         // Precision of the first Newton approximation
+#define SQRT_GUARD_BITS 64
+
+
+/*
+ * Multiplies x and y using up to pieces threads.
+ * The significands are multiplied as integers with mpz_mul_OMP.
+ */
+void mpfr_mul_OMP(mpfr_t r, mpfr_t x, mpfr_t y, int pieces){
+    mpfr_exp_t exp_x, exp_y;
+    mpz_t mant_x, mant_y;
+
+    if (pieces < 2 || !mpfr_regular_p(x) || !mpfr_regular_p(y)){
+        mpfr_mul(r, x, y, MPFR_RNDN);
+        return;
+    }
+
+    mpz_inits(mant_x, mant_y, NULL);
+    exp_x = mpfr_get_z_2exp(mant_x, x);
+    exp_y = mpfr_get_z_2exp(mant_y, y);
+    mpz_mul_OMP(mant_x, mant_x, mant_y, pieces);
+    mpfr_set_z_2exp(r, mant_x, exp_x + exp_y, MPFR_RNDN);
+    mpz_clears(mant_x, mant_y, NULL);
+}
+
+/*
+ * Square root of x using up to pieces threads.
+ * The inverse square root is refined with Newton iterations that double
+ * their precision each time, and all the products are done with mpfr_mul_OMP:
+ *      r = r + r (1 - x r^2) / 2,      sqrt(x) = x r
+ */
+void mpfr_sqrt_OMP(mpfr_t result, mpfr_t x, int pieces){
+    int i, num_steps;
+    mpfr_prec_t precision, step_precision[64];
+    mpfr_t r, x_rounded, aux;
+
+    precision = mpfr_get_prec(result) + SQRT_GUARD_BITS;
+    if (pieces < 2 || precision < MIN_SPLIT_SQRT_BITS || !mpfr_regular_p(x)){
+        mpfr_sqrt(result, x, MPFR_RNDN);
+        return;
+    }
+
+    //Precisions of the Newton steps, from the last one to the first one
+    num_steps = 0;
+    while (precision > SQRT_START_BITS){
+        step_precision[num_steps++] = precision;
+        precision = precision / 2 + SQRT_GUARD_BITS;
+    }
+
+    mpfr_inits2(precision, r, x_rounded, aux, NULL);
+    mpfr_rec_sqrt(r, x, MPFR_RNDN);
+
+    for(i = num_steps - 1; i >= 0; i--){
+        precision = step_precision[i];
+        mpfr_prec_round(r, precision, MPFR_RNDN);
+        mpfr_set_prec(aux, precision);
+        mpfr_set_prec(x_rounded, precision);
+        mpfr_set(x_rounded, x, MPFR_RNDN);
+
+        mpfr_mul_OMP(aux, r, r, pieces);            // aux = 1 - x r^2
+        mpfr_mul_OMP(aux, aux, x_rounded, pieces);
+        mpfr_ui_sub(aux, 1, aux, MPFR_RNDN);
+        mpfr_mul_OMP(aux, aux, r, pieces);          // r = r + r aux / 2
+        mpfr_div_2ui(aux, aux, 1, MPFR_RNDN);
+        mpfr_add(r, r, aux, MPFR_RNDN);
+    }
+    mpfr_mul_OMP(result, x, r, pieces);
+
+    mpfr_clears(r, x_rounded, aux, NULL);
+}
+
+/*
+ * Parallel Pi number calculation using the Gauss Legendre algorithm
+ * Multiple threads can be used
+ * There are too few iterations to divide them among the threads, so each
+ * iteration is parallelized: the update of t and the square root of a b
+ * are independent omp tasks, and their products and the square root
+ * are split among the threads too.
+ */
+void GaussLegendre_algorithm_OMP(mpfr_t pi, int num_iterations, int num_threads, int precision_bits){
+    int i;
+    mpfr_t a, b, t, a_b, diff;
+
+    mpfr_inits2(precision_bits, a, b, t, a_b, diff, NULL);
+    mpfr_set_ui(a, 1, MPFR_RNDN);                   // a = 1
+    mpfr_sqrt_ui(b, 2, MPFR_RNDN);                  // b = 1 / sqrt(2)
+    mpfr_ui_div(b, 1, b, MPFR_RNDN);
+    mpfr_set_ui(t, 1, MPFR_RNDN);                   // t = 1 / 4
+    mpfr_div_2ui(t, t, 2, MPFR_RNDN);
+
+    //Set the number of threads
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel
+    #pragma omp single
+    {
+        for(i = 0; i < num_iterations; i++){
+            #pragma omp task shared(a, b, t, diff)
+            {
+                mpfr_sub(diff, a, b, MPFR_RNDN);                // t = t - p ((a - b) / 2)^2
+                mpfr_mul_OMP(diff, diff, diff, num_threads);
+                mpfr_mul_2si(diff, diff, i - 2, MPFR_RNDN);
+                mpfr_sub(t, t, diff, MPFR_RNDN);
+            }
+            #pragma omp task shared(a, b, a_b)
+            {
+                mpfr_mul_OMP(a_b, a, b, num_threads);           // a_b = sqrt(a b)
+                mpfr_sqrt_OMP(a_b, a_b, num_threads);
+            }
+            #pragma omp taskwait
+
+            mpfr_add(a, a, b, MPFR_RNDN);                       // a = (a + b) / 2
+            mpfr_div_2ui(a, a, 1, MPFR_RNDN);
+            mpfr_swap(b, a_b);                                  // b = sqrt(a b)
+        }
+    }
+
+    mpfr_add(pi, a, b, MPFR_RNDN);                  // pi = (a + b)^2 / 4t
+    mpfr_sqr(pi, pi, MPFR_RNDN);
+    mpfr_div(pi, pi, t, MPFR_RNDN);
+    mpfr_div_2ui(pi, pi, 2, MPFR_RNDN);
+
+    //Clear memory
+    mpfr_free_cache();
+    mpfr_clears(a, b, t, a_b, diff, NULL);
+}
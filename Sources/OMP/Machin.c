@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "../../Headers/Sequential/Series_bs.h"
+#include "../../Headers/Sequential/Machin.h"
+#include "../../Headers/OMP/Series_bs.h"
+#include "../../Headers/Common/Report.h"
+
+#define MIN_TASK_TERMS 64           // Ranges with less terms are not split in tasks
+
+
+/*
+ * Parallel Pi number calculation using a Machin-like formula
+ * Multiple threads can be used
+ * The arctangents are independent, so each one is an omp task that
+ * evaluates its series with binary splitting (Series_bs_OMP) using
+ * a group of threads proportional to its number of terms.
+ * Finally, the values of the arctangents are added.
+ */
+void Machin_algorithm_OMP(mpfr_t pi, const machin_t * formula, int precision, int num_threads){
+    int j, num_iterations;
+    double started;
+    series_t series[MACHIN_MAX_TERMS];
+    mpfr_t terms[MACHIN_MAX_TERMS];
+
+    num_iterations = Machin_iterations(formula, precision);
+    for(j = 0; j < formula -> num_terms; j++){
+        arctan_series(&series[j], formula -> ks[j]);
+        mpfr_init2(terms[j], mpfr_get_prec(pi));
+    }
+
+    //Set the number of threads
+    omp_set_num_threads(num_threads);
+
+    //The leaves of the task trees are the series, the rest of the trees are the merges
+    started = phase_begin();
+    #pragma omp parallel
+    #pragma omp single
+    {
+        for(j = 0; j < formula -> num_terms; j++){
+            #pragma omp task firstprivate(j) shared(series, terms)
+            {
+                int term_iterations, threads, grain;
+                mpz_t P, Q, B, T;
+
+                //Group of threads proportional to the terms of the series
+                term_iterations = arctan_iterations(formula -> ks[j], precision);
+                threads = (int) ((long) num_threads * term_iterations / num_iterations);
+                if (threads < 1) threads = 1;
+                grain = term_iterations / (8 * threads);
+                if (grain < MIN_TASK_TERMS) grain = MIN_TASK_TERMS;
+
+                mpz_inits(P, Q, B, T, NULL);
+                Series_bs_OMP(&series[j], 0, term_iterations, P, Q, B, T, threads, grain);
+                Machin_term_value(terms[j], formula, j, Q, B, T);
+                mpz_clears(P, Q, B, T, NULL);
+            }
+        }
+    }
+    phase_add_rest(PHASE_THREAD_REDUCTION, PHASE_SERIES, phase_begin() - started);
+
+    started = phase_begin();
+    mpfr_set_ui(pi, 0, MPFR_RNDN);
+    for(j = 0; j < formula -> num_terms; j++){
+        mpfr_add(pi, pi, terms[j], MPFR_RNDN);
+        mpfr_clear(terms[j]);
+    }
+    phase_end(PHASE_FINAL, 0, started);
+}
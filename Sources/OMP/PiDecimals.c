@@ -1,31 +1,67 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <mpfr.h>
 #include "../../Headers/OMP/PiCalculator.h"
 #include "../../Headers/Common/Print_title.h"
+#include "../../Headers/Common/Options.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Division_kernel.h"
+#include "../../Headers/Common/Output.h"
+#include "../../Headers/Common/Manifest.h"
+#include "../../Headers/Common/Check_hex_digits.h"
+#include "../../Headers/Common/Checkpoint.h"
+#include "../../Headers/Common/Report.h"
+#include "../../Headers/Common/Autoconfig.h"
 
 
 int incorrect_params(char* exec_name){
     printf("  Number of params are not correct. Try with:\n");
-    printf("    %s algorithm precision \n", exec_name);
+    printf("    %s algorithm precision num_threads [options] \n", exec_name);
+    printf("    %s auto precision [options] \n", exec_name);
+    printf("\n");
+    print_options_usage();
     printf("\n");
 }
 
 int main(int argc, char **argv){    
 
+    //Check the number of parameters are correct, the report format decides where the title goes
+    options_t options;
+    int auto_mode = (argc >= 3 && strcmp(argv[1], "auto") == 0);
+    int first_option = (auto_mode) ? 3 : 4;
+    if(argc < first_option || parse_options(argc, argv, first_option, &options) != 0){
+        print_PiDecimals_title();
+        incorrect_params(argv[0]);
+        exit(-1);
+    }
+    set_report_format(options.report);
+
     print_PiDecimals_title();
     printf("  Parallel OMP version! \n");
     printf("\n");
 
-    //Check the number of parameters are correct
-    if(argc != 4){
-        incorrect_params(argv[0]);
-        exit(-1);
+    //Take algorithm and precision from params, or choose them with the profile
+    int algorithm, num_threads;
+    int precision = atoi(argv[2]);
+    if (auto_mode){
+        autoconfig_t config;
+        auto_configure(options.profile, AUTO_OMP, precision, 1, host_cores(), options.algorithm, options.threads, &config);
+        print_autoconfig(options.profile, &config);
+        printf("\n");
+        algorithm = config.algorithm;
+        num_threads = config.num_threads;
+    } else {
+        algorithm = atoi(argv[1]);    
+        num_threads = atoi(argv[3]);
     }
 
-    //Take algorithm and precision from params
-    int algorithm = atoi(argv[1]);    
-    int precision = atoi(argv[2]);
-    int num_threads = atoi(argv[3]);
+    set_precision_tapering(options.taper);
+    set_division_kernel(options.kernel);
+    set_output_file(options.output);
+    set_manifest_file(options.manifest);
+    set_checkpoint_file(options.checkpoint, options.resume);
+    set_hex_verification(options.verify_hex);
 
     calculate_Pi_OMP(algorithm, precision, num_threads);
 
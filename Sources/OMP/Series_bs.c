@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "../../Headers/Sequential/Series_bs.h"
+#include "../../Headers/OMP/Chudnovsky_bs.h"
+#include "../../Headers/Common/Report.h"
+
+#define MIN_TASK_TERMS 64           // Ranges with less terms are not split in tasks
+
+
+/*
+ * Computes P, Q, B and T of a series for the range of terms [a, b) with omp tasks.
+ * threads is the number of threads that are expected to work on this range,
+ * it is used for splitting the products of the merge between them.
+ */
+void Series_bs_OMP(const series_t * series, int a, int b, mpz_t P, mpz_t Q, mpz_t B, mpz_t T, 
+                    int threads, int grain){
+    int m, pieces;
+    mpz_t P2, Q2, B2, T2;
+
+    if (b - a <= grain){
+        double started = phase_begin();
+        Series_bs(series, a, b, P, Q, B, T);
+        phase_end(PHASE_SERIES, omp_get_thread_num(), started);
+        return;
+    }
+
+    m = a + (b - a) / 2;
+    mpz_inits(P2, Q2, B2, T2, NULL);
+
+    #pragma omp task shared(P, Q, B, T)
+    Series_bs_OMP(series, a, m, P, Q, B, T, (threads + 1) / 2, grain);
+    #pragma omp task shared(P2, Q2, B2, T2)
+    Series_bs_OMP(series, m, b, P2, Q2, B2, T2, (threads + 1) / 2, grain);
+    #pragma omp taskwait
+
+    //Merge: the products that read P and B are done before they are updated
+    pieces = threads / 3;
+    #pragma omp task shared(T, B2, Q2)
+    {
+        mpz_mul_OMP(T, T, B2, pieces);          // T = B2 Q2 T
+        mpz_mul_OMP(T, T, Q2, pieces);
+    }
+    #pragma omp task shared(T2, B, P)
+    {
+        mpz_mul_OMP(T2, T2, B, pieces);         // T2 = B P T2
+        mpz_mul_OMP(T2, T2, P, pieces);
+    }
+    #pragma omp task shared(Q, Q2)
+    mpz_mul_OMP(Q, Q, Q2, pieces);              // Q = Q Q2
+    #pragma omp taskwait
+    #pragma omp task shared(P, P2)
+    mpz_mul_OMP(P, P, P2, pieces);              // P = P P2
+    #pragma omp task shared(B, B2)
+    mpz_mul_OMP(B, B, B2, pieces);              // B = B B2
+    mpz_add(T, T, T2);                          // T = B2 Q2 T + B P T2
+    #pragma omp taskwait
+
+    mpz_clears(P2, Q2, B2, T2, NULL);
+}
+
+/*
+ * Parallel evaluation of the first num_iterations terms of a series
+ * with binary splitting. Multiple threads can be used.
+ * The recursion tree is turned into omp tasks,
+ * and the products of the top merges are also split among threads.
+ */
+void Series_algorithm_bs_OMP(mpfr_t result, const series_t * series, int num_iterations, int num_threads){
+    int grain;
+    double started;
+    mpz_t P, Q, B, T;
+
+    mpz_inits(P, Q, B, T, NULL);
+
+    //Each thread will get around 8 leaf tasks
+    grain = num_iterations / (8 * num_threads);
+    if (grain < MIN_TASK_TERMS) grain = MIN_TASK_TERMS;
+
+    //Set the number of threads
+    omp_set_num_threads(num_threads);
+
+    //The leaves of the task tree are the series, the rest of the tree are the merges
+    started = phase_begin();
+    #pragma omp parallel
+    #pragma omp single
+    Series_bs_OMP(series, 0, num_iterations, P, Q, B, T, num_threads, grain);
+    phase_add_rest(PHASE_THREAD_REDUCTION, PHASE_SERIES, phase_begin() - started);
+
+    started = phase_begin();
+    Series_bs_value(result, Q, B, T);
+    phase_end(PHASE_FINAL, 0, started);
+
+    //Clear memory
+    mpz_clears(P, Q, B, T, NULL);
+}
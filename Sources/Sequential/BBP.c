@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <mpfr.h>
 #include <omp.h>
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Checkpoint.h"
+#include "../../Headers/Common/Report.h"
 
 #define QUOTIENT 0.0625
 
@@ -62,24 +65,74 @@ void BBP_iteration(mpfr_t pi, int n, mpfr_t dep_m,
     mpfr_add(pi, pi, aux, MPFR_RNDN);  
 }
 
+/*
+ * Probe of the cost model: num_terms iterations with working_precision bits
+ */
+void BBP_probe(long working_precision, int num_terms){
+    int i;
+    mpfr_t pi, dep_m, quotient, quot_a, quot_b, quot_c, quot_d, aux;
+
+    mpfr_inits2(working_precision, pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux, NULL);
+    mpfr_init_set_d(quotient, QUOTIENT, MPFR_RNDN);
+    mpfr_set_ui(pi, 0, MPFR_RNDN);
+    mpfr_set_ui(dep_m, 1, MPFR_RNDN);
+    mpfr_div_ui(dep_m, dep_m, 3, MPFR_RNDN);       // Any value that uses all the bits
+
+    for(i = COST_PROBE_FIRST_TERM; i < COST_PROBE_FIRST_TERM + num_terms; i++){
+        BBP_iteration(pi, i, dep_m, quot_a, quot_b, quot_c, quot_d, aux);
+        mpfr_mul(dep_m, dep_m, quotient, MPFR_RNDN);
+    }
+
+    mpfr_clears(pi, dep_m, quotient, quot_a, quot_b, quot_c, quot_d, aux, NULL);
+}
+
 /*
  * Sequential Pi number calculation using the BBP algorithm
  * Single thread implementation
+ * With a checkpoint file, a resumed run computes the blocks of the checkpoint
+ * one after another
  */
 void BBP_algorithm(mpfr_t pi, int num_iterations){   
-    int i;
-    mpfr_t dep_m, quotient, quot_a, quot_b, quot_c, quot_d, aux;
+    int unit, i, block_start, block_end;
+    long precision_bits, working_precision;
+    double started;
+    checkpoint_t checkpoint;
+    mpfr_t local_pi, dep_m, quotient, quot_a, quot_b, quot_c, quot_d, aux;
 
-    mpfr_inits(quot_a, quot_b, quot_c, quot_d, aux, NULL);
-    mpfr_init_set_ui(dep_m, 1, MPFR_RNDN);          // m = (1/16)^n
+    mpfr_inits(local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux, NULL);
     mpfr_init_set_d(quotient, QUOTIENT, MPFR_RNDN); // quotient = (1/16)   
+    precision_bits = mpfr_get_prec(pi);
 
-    for(i = 0; i < num_iterations; i++){ 
-        BBP_iteration(pi, i, dep_m, quot_a, quot_b, quot_c, quot_d, aux);   
-        // Update dependencies:  
-        mpfr_mul(dep_m, dep_m, quotient, MPFR_RNDN);
+    checkpoint_begin(&checkpoint, CHECKPOINT_BBP, num_iterations, 1, precision_bits, BBP_BITS_PER_TERM, 2, 1);
+    checkpoint_start(&checkpoint, 0, checkpoint.num_units);
+
+    started = phase_begin();
+    for(unit = 0; unit < checkpoint.num_units; unit++){
+        block_start = checkpoint_restore(&checkpoint, unit, local_pi, dep_m, NULL);
+        block_end = checkpoint.units[unit].end;
+        if (block_start < 0){
+            block_start = checkpoint.units[unit].start;
+            set_term_precision(precision_bits, local_pi, dep_m, NULL);
+            mpfr_set_ui(local_pi, 0, MPFR_RNDN);
+            mpfr_set_ui_2exp(dep_m, 1, -4L * block_start, MPFR_RNDN);    // m = (1/16)^n
+        }
 
+        for(i = block_start; i < block_end; i++){ 
+            // Only the precision that the term contributes is used (if tapering is enabled):
+            working_precision = term_precision(precision_bits, i, BBP_BITS_PER_TERM);
+            set_term_precision(working_precision, quot_a, quot_b, quot_c, quot_d, aux, NULL);
+            round_term_precision(working_precision, dep_m, NULL);
+            BBP_iteration(local_pi, i, dep_m, quot_a, quot_b, quot_c, quot_d, aux);   
+            // Update dependencies:  
+            mpfr_mul(dep_m, dep_m, quotient, MPFR_RNDN);
+            checkpoint_save(&checkpoint, unit, i + 1, local_pi, dep_m, NULL);
+        }
+        mpfr_add(pi, pi, local_pi, MPFR_RNDN);
     }
+    phase_end(PHASE_SERIES, 0, started);
+
+    checkpoint_end(&checkpoint);
+    checkpoint_remove(&checkpoint);
 
-    mpfr_clears(dep_m, quotient, quot_a, quot_b, quot_c, quot_d, aux, NULL);
+    mpfr_clears(local_pi, dep_m, quotient, quot_a, quot_b, quot_c, quot_d, aux, NULL);
 }
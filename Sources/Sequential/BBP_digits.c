@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../Headers/Sequential/BBP_digits.h"
+
+
+/************************************************************************************
+ * Bailey Borwein Plouffe digit extraction                                          *
+ * It computes the hex digits of pi after a given position without computing       *
+ * the previous ones, using only machine words                                      *
+ *                                                                                  *
+ ************************************************************************************
+ * Bailey Borwein Plouffe formula:                                                  *
+ *                      1        4          2        1       1                      *
+ *    pi = SUMMATORY( ------ [ ------  - ------ - ------ - ------]),  n >=0         *
+ *                     16^n    8n + 1    8n + 4   8n + 5   8n + 6                   *
+ *                                                                                  *
+ * The hex digits after position d are the first ones of frac(16^d pi):            *
+ *                                                                                  *
+ *   frac(16^d pi) = frac(4 S(1) - 2 S(4) - S(5) - S(6))                            *
+ *                                                                                  *
+ *                      d    16^(d-k) mod (8k + j)       inf     16^(d-k)           *
+ *   frac(S(j)) = frac(SUM  ----------------------- + SUM     --------- )           *
+ *                     k=0         8k + j             k=d+1    8k + j               *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * 16^exponent mod modulus by binary exponentiation
+ * The products of moduli below 2^32 fit in a machine word, that is much faster
+ * than the 128 bits division
+ */
+unsigned long pow16_mod(unsigned long exponent, unsigned long modulus){
+    unsigned long word_result, word_base;
+    unsigned __int128 result, base;
+
+    if (modulus == 1) return 0;
+    if (modulus < (1UL << 32)){
+        word_result = 1;
+        word_base = 16 % modulus;
+        while (exponent > 0){
+            if (exponent & 1) word_result = (word_result * word_base) % modulus;
+            word_base = (word_base * word_base) % modulus;
+            exponent >>= 1;
+        }
+        return word_result;
+    }
+    result = 1;
+    base = 16 % modulus;
+    while (exponent > 0){
+        if (exponent & 1) result = (result * base) % modulus;
+        base = (base * base) % modulus;
+        exponent >>= 1;
+    }
+    return (unsigned long) result;
+}
+
+/*
+ * Fractional part of 4 S(1) - 2 S(4) - S(5) - S(6) restricted to the terms k_start <= k < k_end
+ * The result is in [0, 1), so the partial results of disjoint ranges 
+ * can be added and the fractional part taken again
+ */
+long double BBP_digits_partial(long position, long k_start, long k_end){
+    long k;
+    unsigned long denominator;
+    long double sum, power;
+    int j, coefficient[7] = {0, 4, 0, 0, -2, -1, -1};
+
+    sum = 0;
+    for(k = k_start; k < k_end; k++){
+        for(j = 1; j <= 6; j++){
+            if (coefficient[j] == 0) continue;
+            denominator = 8 * k + j;
+            if (k <= position){
+                power = pow16_mod(position - k, denominator);
+            } else {
+                power = powl(16.0L, position - k);
+            }
+            sum += coefficient[j] * (power / denominator);
+        }
+        sum -= floorl(sum);
+    }
+    return sum;
+}
+
+/*
+ * Writes the BBP_HEX_DIGITS first hex digits of fraction in hex
+ */
+void BBP_fraction_to_hex(char * hex, long double fraction){
+    int i, digit;
+    const char * hex_chars = "0123456789ABCDEF";
+
+    fraction -= floorl(fraction);
+    for(i = 0; i < BBP_HEX_DIGITS; i++){
+        fraction *= 16;
+        digit = (int) fraction;
+        hex[i] = hex_chars[digit];
+        fraction -= digit;
+    }
+    hex[BBP_HEX_DIGITS] = '\0';
+}
+
+/*
+ * Sequential computation of the hex digits of pi after position
+ * Single thread implementation
+ */
+void BBP_hex_digits(char * hex, long position){
+    BBP_fraction_to_hex(hex, BBP_digits_partial(position, 0, position + 1 + BBP_TAIL_TERMS));
+}
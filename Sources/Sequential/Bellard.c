@@ -3,6 +3,8 @@
 #include <mpfr.h>
 #include <omp.h>
 #include "../../Headers/Sequential/Bellard_v1.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Report.h"
 
 
 /************************************************************************************
@@ -37,20 +39,50 @@
  *                                                                                  *
  ************************************************************************************/
 
+/*
+ * Probe of the cost model: num_terms iterations with working_precision bits
+ */
+void Bellard_probe(long working_precision, int num_terms){
+    int i;
+    mpfr_t pi, dep_m, a, b, c, d, e, f, g, aux, ONE;
+
+    mpfr_inits2(working_precision, pi, dep_m, a, b, c, d, e, f, g, aux, NULL);
+    mpfr_init_set_ui(ONE, 1, MPFR_RNDN);
+    mpfr_set_ui(pi, 0, MPFR_RNDN);
+    mpfr_set_ui(dep_m, 1, MPFR_RNDN);
+    mpfr_div_ui(dep_m, dep_m, 3, MPFR_RNDN);       // Any value that uses all the bits
+
+    for(i = COST_PROBE_FIRST_TERM; i < COST_PROBE_FIRST_TERM + num_terms; i++){
+        Bellard_iteration_v1(pi, i, dep_m, a, b, c, d, e, f, g, aux, 4 * i, 10 * i);
+        mpfr_mul_2exp(dep_m, ONE, 10 * (i + 1), MPFR_RNDN);
+        mpfr_div(dep_m, ONE, dep_m, MPFR_RNDN);
+    }
+
+    mpfr_clears(pi, dep_m, a, b, c, d, e, f, g, aux, ONE, NULL);
+}
+
 /*
  * Sequential Pi number calculation using the Bellard algorithm
  * Single thread implementation
  */
 void Bellard_algorithm(mpfr_t pi, int num_iterations){   
     int i, dep_a, dep_b, next_i;
+    long precision_bits, working_precision;
+    double started;
     mpfr_t dep_m, a, b, c, d, e, f, g, aux, ONE;    
 
     dep_a = 0, dep_b = 0;       
     mpfr_init_set_ui(dep_m, 1, MPFR_RNDN);          
     mpfr_init_set_ui(ONE, 1, MPFR_RNDN);
     mpfr_inits(a, b, c, d, e, f, g, aux, NULL);
+    precision_bits = mpfr_get_prec(pi);
 
+    started = phase_begin();
     for(i = 0; i < num_iterations; i++){ 
+        // Only the precision that the term contributes is used (if tapering is enabled):
+        working_precision = term_precision(precision_bits, i, BELLARD_BITS_PER_TERM);
+        set_term_precision(working_precision, a, b, c, d, e, f, g, aux, NULL);
+        round_term_precision(working_precision, dep_m, NULL);
         Bellard_iteration_v1(pi, i, dep_m, a, b, c, d, e, f, g, aux, dep_a, dep_b);   
         // Update dependencies for next iteration: 
         next_i = i + 1;
@@ -60,8 +92,11 @@ void Bellard_algorithm(mpfr_t pi, int num_iterations){
         dep_a += 4;
         dep_b += 10;
     }
+    phase_end(PHASE_SERIES, 0, started);
 
+    started = phase_begin();
     mpfr_div_ui(pi, pi, 64, MPFR_RNDN);
+    phase_end(PHASE_FINAL, 0, started);
     
     mpfr_clears(dep_m, a, b, c, d, e, f, g, aux, NULL);
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <mpfr.h>
 #include <omp.h>
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Report.h"
 
 
 /************************************************************************************
@@ -75,12 +77,37 @@ void Bellard_iteration_v1(mpfr_t pi, int n, mpfr_t m, mpfr_t a, mpfr_t b, mpfr_t
     mpfr_add(pi, pi, aux, MPFR_RNDN); 
 }
 
+/*
+ * Probe of the cost model: num_terms iterations with working_precision bits
+ */
+void Bellard_v1_probe(long working_precision, int num_terms){
+    int i;
+    mpfr_t pi, dep_m, jump, a, b, c, d, e, f, g, aux;
+
+    mpfr_inits2(working_precision, pi, dep_m, jump, a, b, c, d, e, f, g, aux, NULL);
+    mpfr_set_ui(pi, 0, MPFR_RNDN);
+    mpfr_set_ui(jump, 1, MPFR_RNDN);
+    mpfr_div_ui(jump, jump, 1024, MPFR_RNDN);
+    mpfr_set_ui(dep_m, 1, MPFR_RNDN);
+    mpfr_div_ui(dep_m, dep_m, 3, MPFR_RNDN);       // Any value that uses all the bits
+
+    for(i = COST_PROBE_FIRST_TERM; i < COST_PROBE_FIRST_TERM + num_terms; i++){
+        Bellard_iteration_v1(pi, i, dep_m, a, b, c, d, e, f, g, aux, 4 * i, 10 * i);
+        mpfr_mul(dep_m, dep_m, jump, MPFR_RNDN);
+        mpfr_neg(dep_m, dep_m, MPFR_RNDN);
+    }
+
+    mpfr_clears(pi, dep_m, jump, a, b, c, d, e, f, g, aux, NULL);
+}
+
 /*
  * Sequential Pi number calculation using the Bellard algorithm
  * Single thread implementation
  */
 void Bellard_algorithm_v1(mpfr_t pi, int num_iterations){   
     int i, dep_a, dep_b;
+    long precision_bits, working_precision;
+    double started;
     mpfr_t dep_m, jump, a, b, c, d, e, f, g, aux;    
 
     dep_a = 0, dep_b = 0;       
@@ -88,8 +115,14 @@ void Bellard_algorithm_v1(mpfr_t pi, int num_iterations){
     mpfr_div_ui(jump, jump, 1024, MPFR_RNDN); 
     mpfr_init_set_ui(dep_m, 1, MPFR_RNDN);          // dep_m = ((-1)^n)/1024)
     mpfr_inits(a, b, c, d, e, f, g, aux, NULL);
+    precision_bits = mpfr_get_prec(pi);
 
+    started = phase_begin();
     for(i = 0; i < num_iterations; i++){ 
+        // Only the precision that the term contributes is used (if tapering is enabled):
+        working_precision = term_precision(precision_bits, i, BELLARD_BITS_PER_TERM);
+        set_term_precision(working_precision, a, b, c, d, e, f, g, aux, NULL);
+        round_term_precision(working_precision, dep_m, NULL);
         Bellard_iteration_v1(pi, i, dep_m, a, b, c, d, e, f, g, aux, dep_a, dep_b);   
         // Update dependencies for next iteration: 
         mpfr_mul(dep_m, dep_m, jump, MPFR_RNDN);
@@ -97,8 +130,11 @@ void Bellard_algorithm_v1(mpfr_t pi, int num_iterations){
         dep_a += 4;
         dep_b += 10;
     }
+    phase_end(PHASE_SERIES, 0, started);
 
+    started = phase_begin();
     mpfr_div_ui(pi, pi, 64, MPFR_RNDN);
+    phase_end(PHASE_FINAL, 0, started);
     
     mpfr_clears(dep_m, jump, a, b, c, d, e, f, g, aux, NULL);
 }
@@ -3,6 +3,11 @@
 #include <gmp.h>
 #include <mpfr.h>
 #include <omp.h>
+#include "../../Headers/Sequential/Chudnovsky_v2.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Checkpoint.h"
+#include "../../Headers/Common/Seeds.h"
+#include "../../Headers/Common/Report.h"
 
 #define A 13591409
 #define B 545140134
@@ -52,48 +57,193 @@ void Chudnovsky_iteration(mpfr_t pi, int n, mpfr_t dep_a, mpfr_t dep_b,
     mpfr_add(pi, pi, aux, MPFR_RNDN);
 }
 
+/*
+ * Updates dep_a from the term n to the term n + 1. dividend and divisor are
+ * auxiliary variables with the working precision
+ */
+void Chudnovsky_update_a(mpfr_t dep_a, int n, mpfr_t dividend, mpfr_t divisor){
+    int factor_a = 12 * n;
+
+    mpfr_set_ui(dividend, factor_a + 2, MPFR_RNDN);
+    mpfr_mul_ui(dividend, dividend, factor_a + 6, MPFR_RNDN);
+    mpfr_mul_ui(dividend, dividend, factor_a + 10, MPFR_RNDN);
+    mpfr_mul(dividend, dividend, dep_a, MPFR_RNDN);
+    mpfr_set_ui(divisor, n + 1, MPFR_RNDN);
+    mpfr_pow_ui(divisor, divisor, 3, MPFR_RNDN);
+    mpfr_div(dep_a, dividend, divisor, MPFR_RNDN);
+}
+
+/*
+ * Probe of the cost model: num_terms iterations with working_precision bits
+ */
+void Chudnovsky_probe(long working_precision, int num_terms){
+    int i;
+    mpfr_t pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, c, aux;
+
+    mpfr_inits2(working_precision, pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, c, aux, NULL);
+    mpfr_set_ui(pi, 0, MPFR_RNDN);
+    mpfr_set_si(c, -C, MPFR_RNDN);
+    mpfr_pow_ui(c, c, 3, MPFR_RNDN);
+    mpfr_set_ui(dep_a, 1, MPFR_RNDN);               // Any values that use all the bits
+    mpfr_div_ui(dep_a, dep_a, 3, MPFR_RNDN);
+    mpfr_set_ui(dep_b, 1, MPFR_RNDN);
+    mpfr_div_ui(dep_b, dep_b, 7, MPFR_RNDN);
+    mpfr_set_ui(dep_c, A, MPFR_RNDN);
+
+    for(i = COST_PROBE_FIRST_TERM; i < COST_PROBE_FIRST_TERM + num_terms; i++){
+        Chudnovsky_iteration(pi, i, dep_a, dep_b, dep_c, aux);
+        Chudnovsky_update_a(dep_a, i, dep_a_dividend, dep_a_divisor);
+        mpfr_mul(dep_b, dep_b, c, MPFR_RNDN);
+        mpfr_add_ui(dep_c, dep_c, B, MPFR_RNDN);
+    }
+
+    mpfr_clears(pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, c, aux, NULL);
+}
+
+/*
+ * dep_a(k + 1) / dep_a(k) = (12k + 2)(12k + 6)(12k + 10) / (k + 1)^3
+ */
+void Chudnovsky_ratio_a(mpz_t p, mpz_t q, long k){
+    mpz_set_ui(p, 12 * k + 2);
+    mpz_mul_ui(p, p, 12 * k + 6);
+    mpz_mul_ui(p, p, 12 * k + 10);
+    mpz_set_ui(q, k + 1);
+    mpz_pow_ui(q, q, 3);
+}
+
+/*
+ * Computes dep_a at the start of the units, in increasing order, in one pass, with
+ * the precision that the terms of each unit need
+ */
+void init_Chudnovsky_seeds(Chudnovsky_seeds_t * seeds, checkpoint_t * checkpoint, const int * units, int num_units, 
+                            long precision_bits, int num_threads){
+    int seed;
+    long working_precision;
+
+    seeds -> num_seeds = num_units;
+    seeds -> starts = malloc(num_units * sizeof(long));
+    seeds -> dep_a = malloc(num_units * sizeof(mpfr_t));
+    for(seed = 0; seed < num_units; seed++){
+        seeds -> starts[seed] = checkpoint -> units[units[seed]].start;
+        working_precision = term_precision(precision_bits, seeds -> starts[seed], CHUDNOVSKY_BITS_PER_TERM);
+        mpfr_init2(seeds -> dep_a[seed], working_precision);
+    }
+
+    seed_recurrence(seeds -> dep_a, seeds -> starts, num_units, Chudnovsky_ratio_a, precision_bits, num_threads);
+}
+
+/*
+ * Sets the dependencies to their values at the start of the unit. If it has no seed
+ * (a stolen unit), dep_a goes there from the closest seed before it with one product
+ * of ratios. dep_b is a power of an integer that is rounded only once
+ */
+void set_Chudnovsky_seed(Chudnovsky_seeds_t * seeds, checkpoint_t * checkpoint, int unit, long precision_bits, 
+                            mpfr_t dep_a, mpfr_t dep_b, mpfr_t dep_c){
+    int seed;
+    long block_start = checkpoint -> units[unit].start;
+    mpfr_t ratio;
+
+    set_term_precision(precision_bits, dep_a, dep_b, dep_c, NULL);
+    seed = seeds -> num_seeds - 1;
+    while (seed >= 0 && seeds -> starts[seed] > block_start) seed--;
+    if (seed >= 0 && seeds -> starts[seed] == block_start){
+        mpfr_set(dep_a, seeds -> dep_a[seed], MPFR_RNDN);
+    } else {
+        segment_ratio(ratio, (seed >= 0) ? seeds -> starts[seed] : 0, block_start, Chudnovsky_ratio_a, 
+                        term_precision(precision_bits, block_start, CHUDNOVSKY_BITS_PER_TERM));
+        if (seed >= 0) mpfr_mul(dep_a, seeds -> dep_a[seed], ratio, MPFR_RNDN);
+        else mpfr_set(dep_a, ratio, MPFR_RNDN);
+        mpfr_clear(ratio);
+    }
+    mpfr_set_si(dep_b, -C, MPFR_RNDN);
+    mpfr_pow_ui(dep_b, dep_b, 3 * block_start, MPFR_RNDN);
+    mpfr_set_ui(dep_c, B, MPFR_RNDN);
+    mpfr_mul_ui(dep_c, dep_c, block_start, MPFR_RNDN);
+    mpfr_add_ui(dep_c, dep_c, A, MPFR_RNDN);
+}
+
+void clear_Chudnovsky_seeds(Chudnovsky_seeds_t * seeds){
+    int seed;
+
+    for(seed = 0; seed < seeds -> num_seeds; seed++){
+        mpfr_clear(seeds -> dep_a[seed]);
+    }
+    free(seeds -> dep_a);
+    free(seeds -> starts);
+}
+
 /*
  * Sequential Pi number calculation using the Chudnovsky algorithm
  * Single thread implementation
+ * With a checkpoint file, a resumed run computes the blocks of the checkpoint
+ * one after another
  */
 void Chudnovsky_algorithm_v2(mpfr_t pi, int num_iterations){
-    int i, factor_a;
-    mpfr_t dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, e, c, aux;
+    int unit, i, block_start, block_end, state_next;
+    long precision_bits, working_precision;
+    double started;
+    checkpoint_t checkpoint;
+    Chudnovsky_seeds_t seeds;
+    mpfr_t local_pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, e, c, aux;
     
     mpfr_inits(dep_a_dividend, dep_a_divisor, aux, NULL);
-    mpfr_inits(dep_a, dep_b, dep_c, e, c, NULL);
-    mpfr_set_ui(dep_a, 1, MPFR_RNDN);
-    mpfr_set_ui(dep_b, 1, MPFR_RNDN);
-    mpfr_set_ui(dep_c, A, MPFR_RNDN);
+    mpfr_inits(local_pi, dep_a, dep_b, dep_c, e, c, NULL);
     mpfr_set_ui(e, E, MPFR_RNDN);
     mpfr_set_ui(c, C, MPFR_RNDN);
     mpfr_neg(c, c, MPFR_RNDN);
     mpfr_pow_ui(c, c, 3, MPFR_RNDN);
+    precision_bits = mpfr_get_prec(pi);
 
-    for(i = 0; i < num_iterations; i ++){
-        Chudnovsky_iteration(pi, i, dep_a, dep_b, dep_c, aux);
-        //Update dep_a:
-        factor_a = (12 * i);
-        mpfr_set_ui(dep_a_dividend, factor_a + 2, MPFR_RNDN); //SOBRECOSTE!!
-        mpfr_mul_ui(dep_a_dividend, dep_a_dividend, factor_a + 6, MPFR_RNDN);
-        mpfr_mul_ui(dep_a_dividend, dep_a_dividend, factor_a + 10, MPFR_RNDN);
-        mpfr_mul(dep_a_dividend, dep_a_dividend, dep_a, MPFR_RNDN);
-
-        mpfr_set_ui(dep_a_divisor, i + 1, MPFR_RNDN); //SOBRECOSTE!!
-        mpfr_pow_ui(dep_a_divisor, dep_a_divisor , 3, MPFR_RNDN);
-        mpfr_div(dep_a, dep_a_dividend, dep_a_divisor, MPFR_RNDN);
-
-        //Update dep_b:
-        mpfr_mul(dep_b, dep_b, c, MPFR_RNDN);
+    checkpoint_begin(&checkpoint, CHECKPOINT_CHUDNOVSKY, num_iterations, 1, precision_bits, 
+                        CHUDNOVSKY_BITS_PER_TERM, 4, 1);
+    checkpoint_start(&checkpoint, 0, checkpoint.num_units);
 
-        //Update dep_c:
-        mpfr_add_ui(dep_c, dep_c, B, MPFR_RNDN);
-        
+    started = phase_begin();
+    state_next = -1;                                // Iteration of the dependencies
+    for(unit = 0; unit < checkpoint.num_units; unit++){
+        block_start = checkpoint_restore(&checkpoint, unit, local_pi, dep_a, dep_b, dep_c, NULL);
+        block_end = checkpoint.units[unit].end;
+        if (block_start < 0){
+            block_start = checkpoint.units[unit].start;
+            set_term_precision(precision_bits, local_pi, NULL);
+            mpfr_set_ui(local_pi, 0, MPFR_RNDN);
+            if (block_start != state_next){
+                init_Chudnovsky_seeds(&seeds, &checkpoint, &unit, 1, precision_bits, 1);
+                set_Chudnovsky_seed(&seeds, &checkpoint, unit, precision_bits, dep_a, dep_b, dep_c);
+                clear_Chudnovsky_seeds(&seeds);
+            }
+        }
+
+        for(i = block_start; i < block_end; i ++){
+            // Only the precision that the term contributes is used (if tapering is enabled):
+            working_precision = term_precision(precision_bits, i, CHUDNOVSKY_BITS_PER_TERM);
+            set_term_precision(working_precision, dep_a_dividend, dep_a_divisor, aux, NULL);
+            round_term_precision(working_precision, dep_a, dep_b, dep_c, NULL);
+            Chudnovsky_iteration(local_pi, i, dep_a, dep_b, dep_c, aux);
+            //Update dep_a:
+            Chudnovsky_update_a(dep_a, i, dep_a_dividend, dep_a_divisor);
+
+            //Update dep_b:
+            mpfr_mul(dep_b, dep_b, c, MPFR_RNDN);
+
+            //Update dep_c:
+            mpfr_add_ui(dep_c, dep_c, B, MPFR_RNDN);
+            checkpoint_save(&checkpoint, unit, i + 1, local_pi, dep_a, dep_b, dep_c, NULL);
+        }
+        state_next = block_end;
+        mpfr_add(pi, pi, local_pi, MPFR_RNDN);
     }
+    phase_end(PHASE_SERIES, 0, started);
+
+    checkpoint_end(&checkpoint);
+    checkpoint_remove(&checkpoint);
+
+    started = phase_begin();
     mpfr_sqrt(e, e, MPFR_RNDN);
     mpfr_mul_ui(e, e, D, MPFR_RNDN);
     mpfr_div(pi, e, pi, MPFR_RNDN);    
+    phase_end(PHASE_FINAL, 0, started);
     
     //Clear memory
-    mpfr_clears(dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, e, c, aux, NULL);
+    mpfr_clears(local_pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, e, c, aux, NULL);
 }
@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+
+#define A 13591409
+#define B 545140134
+#define C3_OVER_24 10939058860032000
+#define D 426880
+#define E 10005
+
+
+/************************************************************************************
+ * Chudnovsky formula implementation                                                *
+ * This version evaluates the series by binary splitting                            *
+ * All the terms are computed with exact integers, so there is only one             *
+ * full precision division and one square root at the end                           *
+ *                                                                                  *
+ ************************************************************************************
+ * Chudnovsky formula:                                                              *
+ *     426880 sqrt(10005)                 (6n)! (545140134n + 13591409)             *
+ *    --------------------  = SUMMATORY( ----------------------------- ),  n >=0    *
+ *            pi                            (n!)^3 (3n)! (-640320)^3n               *
+ *                                                                                  *
+ ************************************************************************************
+ * Binary splitting of the range [a, b):                                            *
+ *                                                                                  *
+ *      Leaf (b = a + 1):                                                           *
+ *          P(a, a+1) = (6a - 5)(2a - 1)(6a - 1)          (P(0, 1) = 1)             *
+ *          Q(a, a+1) = a^3 640320^3 / 24                 (Q(0, 1) = 1)             *
+ *          T(a, a+1) = (-1)^a P(a, a+1) (545140134a + 13591409)                    *
+ *                                                                                  *
+ *      Merge (a < m < b):                                                          *
+ *          P(a, b) = P(a, m) P(m, b)                                               *
+ *          Q(a, b) = Q(a, m) Q(m, b)                                               *
+ *          T(a, b) = Q(m, b) T(a, m) + P(a, m) T(m, b)                             *
+ *                                                                                  *
+ *      Result:                                                                     *
+ *                  426880 sqrt(10005) Q(0, n)                                      *
+ *            pi = ---------------------------                                      *
+ *                          T(0, n)                                                 *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * Computes P, Q and T for the single term a
+ */
+void Chudnovsky_bs_leaf(int a, mpz_t P, mpz_t Q, mpz_t T){
+    if (a == 0){
+        mpz_set_ui(P, 1);
+        mpz_set_ui(Q, 1);
+    } else {
+        mpz_set_ui(P, 6 * (unsigned long) a - 5);       // P = (6a - 5)(2a - 1)(6a - 1)
+        mpz_mul_ui(P, P, 2 * (unsigned long) a - 1);
+        mpz_mul_ui(P, P, 6 * (unsigned long) a - 1);
+        mpz_set_ui(Q, a);                               // Q = a^3 640320^3 / 24
+        mpz_mul_ui(Q, Q, a);
+        mpz_mul_ui(Q, Q, a);
+        mpz_mul_ui(Q, Q, C3_OVER_24);
+    }
+    mpz_set_ui(T, B);                                   // T = P (545140134a + 13591409)
+    mpz_mul_ui(T, T, a);
+    mpz_add_ui(T, T, A);
+    mpz_mul(T, T, P);
+    if (a % 2 != 0) mpz_neg(T, T);
+}
+
+/*
+ * Merges the right range (P2, Q2, T2) into the left range (P, Q, T)
+ * The right range must start where the left one ends. T2 is overwritten
+ * P is not updated if need_P is zero (right-most ranges never need it)
+ */
+void Chudnovsky_bs_merge(mpz_t P, mpz_t Q, mpz_t T, mpz_t P2, mpz_t Q2, mpz_t T2, int need_P){
+    mpz_mul(T, T, Q2);      // T = Q2 T + P T2
+    mpz_mul(T2, T2, P);
+    mpz_add(T, T, T2);
+    if (need_P) mpz_mul(P, P, P2);      // P = P P2
+    mpz_mul(Q, Q, Q2);      // Q = Q Q2
+}
+
+/*
+ * Computes P, Q and T for the range of terms [a, b)
+ */
+void Chudnovsky_bs(int a, int b, mpz_t P, mpz_t Q, mpz_t T){
+    int m;
+    mpz_t P2, Q2, T2;
+
+    if (b - a == 1){
+        Chudnovsky_bs_leaf(a, P, Q, T);
+        return;
+    }
+
+    m = a + (b - a) / 2;
+    mpz_inits(P2, Q2, T2, NULL);
+    Chudnovsky_bs(a, m, P, Q, T);
+    Chudnovsky_bs(m, b, P2, Q2, T2);
+    Chudnovsky_bs_merge(P, Q, T, P2, Q2, T2, 1);
+    mpz_clears(P2, Q2, T2, NULL);
+}
+
+/*
+ * Computes pi from Q(0, n) and T(0, n) with the precision of pi
+ */
+void Chudnovsky_bs_pi(mpfr_t pi, mpz_t Q, mpz_t T){
+    mpfr_t e, aux;
+
+    mpfr_inits2(mpfr_get_prec(pi), e, aux, NULL);
+    mpfr_sqrt_ui(e, E, MPFR_RNDN);
+    mpfr_mul_ui(e, e, D, MPFR_RNDN);
+    mpfr_mul_z(e, e, Q, MPFR_RNDN);
+    mpfr_set_z(aux, T, MPFR_RNDN);
+    mpfr_div(pi, e, aux, MPFR_RNDN);
+
+    mpfr_clears(e, aux, NULL);
+}
+
+/*
+ * Sequential Pi number calculation using the Chudnovsky algorithm
+ * with binary splitting. Single thread implementation
+ */
+void Chudnovsky_algorithm_bs(mpfr_t pi, int num_iterations){
+    mpz_t P, Q, T;
+
+    mpz_inits(P, Q, T, NULL);
+    Chudnovsky_bs(0, num_iterations, P, Q, T);
+    Chudnovsky_bs_pi(pi, Q, T);
+
+    //Clear memory
+    mpz_clears(P, Q, T, NULL);
+}
@@ -0,0 +1,269 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include <stdint.h>
+#include "../../Headers/Sequential/Fixed_point.h"
+#include "../../Headers/Common/Division_kernel.h"
+
+//The batched kernel works on 32 bit digits over the limbs of the sum
+#if GMP_NUMB_BITS == 64 && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define FIXED_POINT_DIGITS
+#endif
+#define DIGITS_PER_LIMB (GMP_NUMB_BITS / DIVISION_DIGIT_BITS)
+
+
+/************************************************************************************
+ * Fixed point summation of BBP-like series                                         *
+ * All the terms share the implicit scale 2^-F, where F is the number of bits       *
+ * of the fraction limbs, and the sum is a plain array of limbs:                    *
+ *                                                                                  *
+ *      sum[size - 1]           -> integer part (two's complement)                  *
+ *      sum[size - 2] ... sum[0] -> fraction part                                   *
+ *                                                                                  *
+ ************************************************************************************
+ * Series:                                                                          *
+ *                        (+-1)^n        2^e(j)                                     *
+ *    S = 2^s SUMMATORY( --------- SUM( ------------- ) ),  n >= 0                  *
+ *                          2^rn         a(j)n + b(j)                               *
+ *                                                                                  *
+ * Every component is 2^(F + s + e(j) - rn) / (a(j)n + b(j)) in the fixed point     *
+ * scale: the numerator is a single bit, so its quotient is computed with           *
+ * mpn_divrem_1 over the limbs below that bit only, and then added or               *
+ * subtracted with carry propagation. The division by 2^rn is a shift               *
+ *                                                                                  *
+ * With a batched division kernel the components of several consecutive terms       *
+ * are divided together (Division_kernel) and their signed quotient digits are      *
+ * added to the sum in a single carry propagation pass                              *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * Bailey Borwein Plouffe formula:
+ *              1        4          2        1       1
+ *    pi = SUM(---- [ ------  - ------ - ------ - ------])
+ *             16^n    8n + 1    8n + 4   8n + 5   8n + 6
+ */
+const fixed_series_t BBP_fixed_series = {
+    .log2_ratio = 4,
+    .log2_scale = 0,
+    .alternating = 0,
+    .num_components = 4,
+    .components = {
+        { 1, 2, 8, 1},
+        {-1, 1, 8, 4},
+        {-1, 0, 8, 5},
+        {-1, 0, 8, 6},
+    },
+};
+
+/*
+ * Bellard formula:
+ *             (-1)^n      32       1        256       64        4        4        1
+ *    pi = SUM(------- [- ---- - ----- + ------ - ------ - ------ - ------ + ------])
+ *             2^6 2^10n  4n+1    4n+3    10n+1   10n+3    10n+5    10n+7    10n+9
+ */
+const fixed_series_t Bellard_fixed_series = {
+    .log2_ratio = 10,
+    .log2_scale = -6,
+    .alternating = 1,
+    .num_components = 7,
+    .components = {
+        {-1, 5, 4, 1},
+        {-1, 0, 4, 3},
+        { 1, 8, 10, 1},
+        {-1, 6, 10, 3},
+        {-1, 2, 10, 5},
+        {-1, 2, 10, 7},
+        { 1, 0, 10, 9},
+    },
+};
+
+
+/*
+ * Number of limbs of a fixed point number with at least precision_bits
+ * fraction bits, the guard limbs and the integer limb
+ */
+mp_size_t Fixed_point_size(long precision_bits){
+    return (precision_bits + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS + FIXED_POINT_GUARD_LIMBS + 1;
+}
+
+/*
+ * Adds the term n of the series to sum with mpn_divrem_1.
+ * quotient is a scratch array of size limbs
+ */
+void Fixed_point_add_term(mp_ptr sum, mp_size_t size, const fixed_series_t * series, long n, mp_ptr quotient){
+    int j, sign;
+    long position;
+    mp_size_t shift_limbs;
+    mp_limb_t numerator;
+    const fixed_component_t * component;
+
+    for(j = 0; j < series -> num_components; j++){
+        component = &series -> components[j];
+        position = (size - 1) * GMP_NUMB_BITS + series -> log2_scale + component -> log2_coeff
+                        - series -> log2_ratio * n;
+        if (position < 0) continue;             // The term is below the last bit
+
+        shift_limbs = position / GMP_NUMB_BITS;
+        numerator = (mp_limb_t) 1 << (position % GMP_NUMB_BITS);
+        mpn_divrem_1(quotient, shift_limbs, &numerator, 1, component -> den_a * n + component -> den_b);
+
+        sign = component -> sign;
+        if (series -> alternating && n % 2 != 0) sign = -sign;
+        if (sign > 0) mpn_add(sum, sum, size, quotient, shift_limbs + 1);
+        else mpn_sub(sum, sum, size, quotient, shift_limbs + 1);
+    }
+}
+
+/*
+ * Adds the signed digits digits[0] ... digits[num_digits - 1] to sum,
+ * propagating the carries from the least significant digit
+ */
+void Fixed_point_add_digits(mp_ptr sum, mp_size_t size, const int64_t * digits, long num_digits){
+    long k, sum_digits;
+    int64_t t, carry;
+    uint32_t * sum_digit;
+
+    sum_digit = (uint32_t *) sum;
+    sum_digits = size * DIGITS_PER_LIMB;
+    carry = 0;
+    for(k = 0; k < num_digits; k++){
+        t = (int64_t) sum_digit[k] + digits[k] + carry;
+        sum_digit[k] = (uint32_t) t;
+        carry = t >> DIVISION_DIGIT_BITS;
+    }
+    for(; carry != 0 && k < sum_digits; k++){
+        t = (int64_t) sum_digit[k] + carry;
+        sum_digit[k] = (uint32_t) t;
+        carry = t >> DIVISION_DIGIT_BITS;
+    }
+}
+
+/*
+ * Adds the terms first, first + step... lower than last with the batched
+ * division kernel, as many as fit in its lanes.
+ * digits is a scratch array of 2 size digits.
+ * Returns the first term that was not added
+ */
+long Fixed_point_add_batch(mp_ptr sum, mp_size_t size, const fixed_series_t * series, long first, long last, 
+                                long step, int64_t * digits){
+    int j, lane, sign;
+    long n, k, position, top, bottom, lead[DIVISION_MAX_LANES];
+    uint64_t q, rem, divisor;
+    division_lanes_t lanes;
+    const fixed_component_t * component;
+
+    lanes.num_lanes = 0;
+    for(n = first; n < last && lanes.num_lanes + series -> num_components <= DIVISION_MAX_LANES; n += step){
+        for(j = 0; j < series -> num_components; j++){
+            component = &series -> components[j];
+            position = (size - 1) * GMP_NUMB_BITS + series -> log2_scale + component -> log2_coeff
+                            - series -> log2_ratio * n;
+            if (position < 0) continue;             // The term is below the last bit
+
+            sign = component -> sign;
+            if (series -> alternating && n % 2 != 0) sign = -sign;
+            lead[lanes.num_lanes] = position;
+            division_lane(&lanes, 0, component -> den_a * n + component -> den_b, sign < 0);
+        }
+    }
+    if (lanes.num_lanes == 0) return n;
+
+    top = 0;
+    bottom = lead[0] / DIVISION_DIGIT_BITS;
+    for(lane = 0; lane < lanes.num_lanes; lane++){
+        k = lead[lane] / DIVISION_DIGIT_BITS;
+        if (k > top) top = k;
+        if (k < bottom) bottom = k;
+    }
+    for(k = bottom; k <= top; k++) digits[k] = 0;
+
+    //Leading digits: every lane divides its bit and the digits down to the common one
+    for(lane = 0; lane < lanes.num_lanes; lane++){
+        divisor = lanes.divisor[lane];
+        rem = (uint64_t) 1 << (lead[lane] % DIVISION_DIGIT_BITS);
+        for(k = lead[lane] / DIVISION_DIGIT_BITS; k >= bottom; k--){
+            q = rem / divisor;
+            rem = (rem % divisor) << DIVISION_DIGIT_BITS;
+            digits[k] += (lanes.negative[lane]) ? -(int64_t) q : (int64_t) q;
+        }
+        lanes.rem[lane] = rem >> DIVISION_DIGIT_BITS;
+    }
+
+    //Remaining digits: all the lanes together
+    division_kernel(digits, bottom, &lanes);
+    Fixed_point_add_digits(sum, size, digits, top + 1);
+    return n;
+}
+
+/*
+ * Adds the terms first, first + step, first + 2 step... lower than last to sum
+ */
+void Fixed_point_sum(mp_ptr sum, mp_size_t size, const fixed_series_t * series, long first, long last, long step){
+    int j, batched;
+    long n;
+    mp_ptr quotient;
+    int64_t * digits;
+
+    //Batched kernel only if every divisor fits in its lanes
+    batched = get_division_kernel() != DIVISION_KERNEL_MPN;
+    for(j = 0; j < series -> num_components; j++){
+        if (series -> components[j].den_a * last + series -> components[j].den_b > DIVISION_MAX_DIVISOR) batched = 0;
+    }
+#ifndef FIXED_POINT_DIGITS
+    batched = 0;
+#endif
+
+    if (batched){
+        digits = malloc(size * DIGITS_PER_LIMB * sizeof(int64_t));
+        for(n = first; n < last; ){
+            n = Fixed_point_add_batch(sum, size, series, n, last, step, digits);
+        }
+        free(digits);
+    } else {
+        quotient = malloc(size * sizeof(mp_limb_t));
+        for(n = first; n < last; n += step){
+            Fixed_point_add_term(sum, size, series, n, quotient);
+        }
+        free(quotient);
+    }
+}
+
+/*
+ * Converts the fixed point number to mpfr with the precision of result
+ */
+void Fixed_point_to_mpfr(mpfr_t result, mp_srcptr sum, mp_size_t size){
+    int negative;
+    mp_ptr limbs;
+    mpz_t value;
+
+    negative = (sum[size - 1] >> (GMP_NUMB_BITS - 1)) != 0;
+    mpz_init(value);
+    limbs = mpz_limbs_write(value, size);
+    if (negative) mpn_neg(limbs, sum, size);
+    else mpn_copyi(limbs, sum, size);
+    mpz_limbs_finish(value, negative ? -size : size);
+
+    mpfr_set_z_2exp(result, value, -(size - 1) * GMP_NUMB_BITS, MPFR_RNDN);
+    mpz_clear(value);
+}
+
+/*
+ * Sequential Pi number calculation with a fixed point series
+ * Single thread implementation
+ */
+void Fixed_point_algorithm(mpfr_t pi, const fixed_series_t * series, int num_iterations){
+    mp_size_t size;
+    mp_ptr sum;
+
+    size = Fixed_point_size(mpfr_get_prec(pi));
+    sum = calloc(size, sizeof(mp_limb_t));
+    Fixed_point_sum(sum, size, series, 0, num_iterations, 1);
+    Fixed_point_to_mpfr(pi, sum, size);
+
+    //Clear memory
+    free(sum);
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpfr.h>
+#include <omp.h>
+
+
+/************************************************************************************
+ * Gauss Legendre algorithm implementation                                          *
+ * It is based on the arithmetic-geometric mean (AGM) of 1 and 1/sqrt(2)            *
+ * The number of correct digits doubles with each iteration, so only                *
+ * log2(precision) full precision iterations are needed                             *
+ *                                                                                  *
+ ************************************************************************************
+ * Initial values:                                                                  *
+ *          a(0) = 1,   b(0) = 1 / sqrt(2),   t(0) = 1 / 4,   p(0) = 1              *
+ *                                                                                  *
+ * Iteration:                                                                       *
+ *                   a(n) + b(n)                                                    *
+ *        a(n+1) = -------------,          b(n+1) = sqrt( a(n) b(n) )               *
+ *                        2                                                         *
+ *                                                                                  *
+ *                                a(n) - b(n)                                       *
+ *        t(n+1) = t(n) - p(n) ( ------------- )^2,       p(n+1) = 2 p(n)           *
+ *                                     2                                            *
+ *                                                                                  *
+ * Result:                                                                          *
+ *                  ( a(n) + b(n) )^2                                               *
+ *           pi ~= -------------------                                              *
+ *                       4 t(n)                                                     *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * An iteration of the Gauss Legendre algorithm
+ * p is stored as its base 2 logarithm
+ */
+void GaussLegendre_iteration(mpfr_t a, mpfr_t b, mpfr_t t, int log_p, mpfr_t aux){
+    mpfr_sub(aux, a, b, MPFR_RNDN);                 // aux = p ((a - b) / 2)^2
+    mpfr_sqr(aux, aux, MPFR_RNDN);
+    mpfr_mul_2si(aux, aux, log_p - 2, MPFR_RNDN);
+    mpfr_sub(t, t, aux, MPFR_RNDN);                 // t = t - aux
+
+    mpfr_mul(aux, a, b, MPFR_RNDN);                 // aux = a b
+    mpfr_add(a, a, b, MPFR_RNDN);                   // a = (a + b) / 2
+    mpfr_div_2ui(a, a, 1, MPFR_RNDN);
+    mpfr_sqrt(b, aux, MPFR_RNDN);                   // b = sqrt(a b)
+}
+
+/*
+ * Computes pi from the last values of a, b and t
+ */
+void GaussLegendre_pi(mpfr_t pi, mpfr_t a, mpfr_t b, mpfr_t t){
+    mpfr_add(pi, a, b, MPFR_RNDN);
+    mpfr_sqr(pi, pi, MPFR_RNDN);
+    mpfr_div(pi, pi, t, MPFR_RNDN);
+    mpfr_div_2ui(pi, pi, 2, MPFR_RNDN);
+}
+
+/*
+ * Sequential Pi number calculation using the Gauss Legendre algorithm
+ * Single thread implementation
+ */
+void GaussLegendre_algorithm(mpfr_t pi, int num_iterations){
+    int i;
+    mpfr_t a, b, t, aux;
+
+    mpfr_inits2(mpfr_get_prec(pi), a, b, t, aux, NULL);
+    mpfr_set_ui(a, 1, MPFR_RNDN);                   // a = 1
+    mpfr_sqrt_ui(b, 2, MPFR_RNDN);                  // b = 1 / sqrt(2)
+    mpfr_ui_div(b, 1, b, MPFR_RNDN);
+    mpfr_set_ui(t, 1, MPFR_RNDN);                   // t = 1 / 4
+    mpfr_div_2ui(t, t, 2, MPFR_RNDN);
+
+    for(i = 0; i < num_iterations; i++){
+        GaussLegendre_iteration(a, b, t, i, aux);
+    }
+
+    GaussLegendre_pi(pi, a, b, t);
+
+    //Clear memory
+    mpfr_clears(a, b, t, aux, NULL);
+}
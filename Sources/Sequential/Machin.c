@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <math.h>
+#include <omp.h>
+#include "../../Headers/Sequential/Series_bs.h"
+#include "../../Headers/Sequential/Machin.h"
+
+
+/************************************************************************************
+ * Machin-like formulas implementation                                              *
+ * Pi is a linear combination of arctangents of 1/k, each one is an independent     *
+ * series evaluated with binary splitting (Series_bs)                               *
+ *                                                                                  *
+ ************************************************************************************
+ * Machin-like formula:                                                             *
+ *          pi                                                                      *
+ *         ---- = SUMMATORY( c(j) arctan(1 / k(j)) )                                *
+ *           4                                                                      *
+ *                                                                                  *
+ * Arctangent series:                                                               *
+ *                       1                    1            -1                       *
+ *     arctan(1/k) = --- SUMMATORY( -------- ( ----- )^n ),  n >= 0                 *
+ *                    k                2n + 1      k^2                              *
+ *                                                                                  *
+ * Each term is 1 / k^2 of the previous one, so log10(k^2) decimals are             *
+ * obtained per term                                                                *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * Takano formula:
+ *    pi / 4 = 12 arctan(1/49) + 32 arctan(1/57) - 5 arctan(1/239) + 12 arctan(1/110443)
+ */
+const machin_t Takano_formula = {
+    .num_terms = 4,
+    .coeffs = {12, 32, -5, 12},
+    .ks = {49, 57, 239, 110443},
+};
+
+/*
+ * Stormer formula:
+ *    pi / 4 = 44 arctan(1/57) + 7 arctan(1/239) - 12 arctan(1/682) + 24 arctan(1/12943)
+ */
+const machin_t Stormer_formula = {
+    .num_terms = 4,
+    .coeffs = {44, 7, -12, 24},
+    .ks = {57, 239, 682, 12943},
+};
+
+
+/*
+ * Describes the series of k arctan(1/k)
+ */
+void arctan_series(series_t * series, long k){
+    series -> a.degree = 0;                 // a(n) = 1
+    series -> a.coeffs[0] = 1;
+    series -> b.degree = 1;                 // b(n) = 2n + 1
+    series -> b.coeffs[0] = 1;
+    series -> b.coeffs[1] = 2;
+    series -> p.degree = 0;                 // r(n) = -1 / k^2
+    series -> p.coeffs[0] = -1;
+    series -> q.degree = 0;
+    series -> q.coeffs[0] = k * k;
+}
+
+/*
+ * Number of terms of the arctan(1/k) series needed for precision decimals
+ */
+int arctan_iterations(long k, int precision){
+    return (int) ceil(precision / (2 * log10(k))) + 1;
+}
+
+/*
+ * Number of terms of all the arctangents of the formula
+ */
+int Machin_iterations(const machin_t * formula, int precision){
+    int j, num_iterations;
+
+    num_iterations = 0;
+    for(j = 0; j < formula -> num_terms; j++){
+        num_iterations += arctan_iterations(formula -> ks[j], precision);
+    }
+    return num_iterations;
+}
+
+/*
+ * Computes 4 c(j) arctan(1 / k(j)) for the term j of the formula
+ * from the integers of its series. B is overwritten
+ */
+void Machin_term_value(mpfr_t result, const machin_t * formula, int j, mpz_t Q, mpz_t B, mpz_t T){
+    Series_bs_value(result, Q, B, T);
+    mpfr_mul_si(result, result, 4 * formula -> coeffs[j], MPFR_RNDN);
+    mpfr_div_ui(result, result, formula -> ks[j], MPFR_RNDN);
+}
+
+/*
+ * Sequential Pi number calculation using a Machin-like formula
+ * Single thread implementation
+ */
+void Machin_algorithm(mpfr_t pi, const machin_t * formula, int precision){
+    int j;
+    series_t series;
+    mpz_t P, Q, B, T;
+    mpfr_t term;
+
+    mpz_inits(P, Q, B, T, NULL);
+    mpfr_init2(term, mpfr_get_prec(pi));
+    mpfr_set_ui(pi, 0, MPFR_RNDN);
+
+    for(j = 0; j < formula -> num_terms; j++){
+        arctan_series(&series, formula -> ks[j]);
+        Series_bs(&series, 0, arctan_iterations(formula -> ks[j], precision), P, Q, B, T);
+        Machin_term_value(term, formula, j, Q, B, T);
+        mpfr_add(pi, pi, term, MPFR_RNDN);
+    }
+
+    //Clear memory
+    mpz_clears(P, Q, B, T, NULL);
+    mpfr_clear(term);
+}
@@ -2,11 +2,24 @@
 #include <stdlib.h>
 #include <mpfr.h>
 #include <time.h>
+#include <math.h>
 #include "../../Headers/Sequential/BBP.h"
 #include "../../Headers/Sequential/Bellard.h"
 #include "../../Headers/Sequential/Bellard_v1.h"
 #include "../../Headers/Sequential/Chudnovsky_v2.h"
+#include "../../Headers/Sequential/Chudnovsky_bs.h"
+#include "../../Headers/Sequential/Series_bs.h"
+#include "../../Headers/Sequential/BBP_digits.h"
+#include "../../Headers/Sequential/GaussLegendre.h"
+#include "../../Headers/Sequential/Machin.h"
+#include "../../Headers/Sequential/Fixed_point.h"
 #include "../../Headers/Common/Check_decimals.h"
+#include "../../Headers/Common/Check_hex_digits.h"
+#include "../../Headers/Common/Planner.h"
+#include "../../Headers/Common/Output.h"
+#include "../../Headers/Common/Manifest.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Report.h"
 
 
 double gettimeofday();
@@ -18,18 +31,52 @@ void check_errors(int precision, int num_iterations){
     } 
 }
 
-void print_running_properties(int precision, int num_iterations){
+void print_running_properties(int precision, int num_iterations, plan_t * plan){
     printf("  Precision used: %d \n", precision);
     printf("  Iterations done: %d \n", num_iterations);
+    print_plan(plan);
 }
 
-void calculate_Pi(int algorithm, int precision){
+void calculate_hex_digits(int position){
     double execution_time;
     struct timeval t1, t2;
+    char hex[BBP_HEX_DIGITS + 1];
+
+    if (position < 0){
+        printf("  Position should not be negative. \n\n");
+        exit(-1);
+    }
+
+    gettimeofday(&t1, NULL);
+    printf("  Algorithm: BBP (Hexadecimal digit extraction) \n");
+    printf("  Position: %d \n", position);
+    BBP_hex_digits(hex, position);
+    gettimeofday(&t2, NULL);
+    execution_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
+    printf("  Hex digits: %s \n", hex);
+    printf("  Execution time: %f seconds \n", execution_time);
+    printf("\n");
+}
+
+void calculate_Pi(int algorithm, int precision){
+    double execution_time, started, hex_seconds;
+    struct timeval t1, t2;
     mpfr_t pi;
-    int num_iterations, decimals_computed, precision_bits;
+    plan_t plan;
+    int num_iterations, decimals_computed, hex_matches, precision_bits;
+
+    //BBP digit extraction does not compute pi, precision is the position of the digits
+    if (algorithm == 7){
+        calculate_hex_digits(precision);
+        return;
+    }
     
-    precision_bits = precision * 8;
+    //A manifest that can not check the run is found out before computing it
+    if (get_manifest_file() != NULL && check_manifest_length(get_manifest_file(), precision) != 0) exit(-1);
+
+    plan_algorithm(algorithm, precision, &plan);
+    precision_bits = plan.precision_bits;
+    reset_phases(1);
     gettimeofday(&t1, NULL);
 
     //Set mpfr float precision (in bits) and init pi
@@ -37,39 +84,105 @@ void calculate_Pi(int algorithm, int precision){
     mpfr_set_default_prec(precision_bits); 
     mpfr_init_set_ui(pi, 0, MPFR_RNDN);
     
+    //The algorithms without timers of their own are all series
+    started = phase_begin();
     switch (algorithm)
     {
     case 0:
-        num_iterations = precision * 0.84;
+        num_iterations = plan.num_iterations;
         check_errors(precision, num_iterations);
         printf("  Algorithm: BBP \n");
-        print_running_properties(precision, num_iterations);
+        print_running_properties(precision, num_iterations, &plan);
         BBP_algorithm(pi, num_iterations);
         break;
 
     case 1:
-        num_iterations = precision / 3;
+        num_iterations = plan.num_iterations;
         check_errors(precision, num_iterations);
         printf("  Algorithm: Bellard (First version) \n");
-        print_running_properties(precision, num_iterations);
+        print_running_properties(precision, num_iterations, &plan);
         Bellard_algorithm_v1(pi, num_iterations);
         break;
     
     case 2:
-        num_iterations = precision / 3;
+        num_iterations = plan.num_iterations;
         check_errors(precision, num_iterations);
         printf("  Algorithm: Bellard (Last version) \n");
-        print_running_properties(precision, num_iterations);
+        print_running_properties(precision, num_iterations, &plan);
         Bellard_algorithm(pi, num_iterations);
         break;
 
     case 3:
-        num_iterations = (precision + 14 - 1) / 14;  //Division por exceso
+        num_iterations = plan.num_iterations;
         check_errors(precision, num_iterations);
         printf("  Algorithm: Chudnovsky (Last version) \n");
-        print_running_properties(precision, num_iterations);
+        print_running_properties(precision, num_iterations, &plan);
         Chudnovsky_algorithm_v2(pi, num_iterations);
         break;
+
+    case 4:
+        num_iterations = plan.num_iterations;
+        check_errors(precision, num_iterations);
+        printf("  Algorithm: Chudnovsky (Binary splitting) \n");
+        print_running_properties(precision, num_iterations, &plan);
+        Chudnovsky_algorithm_bs(pi, num_iterations);
+        break;
+
+    case 5:
+        num_iterations = plan.num_iterations;
+        check_errors(precision, num_iterations);
+        printf("  Algorithm: BBP (Binary splitting) \n");
+        print_running_properties(precision, num_iterations, &plan);
+        Series_algorithm_bs(pi, &BBP_series, num_iterations);
+        break;
+
+    case 6:
+        num_iterations = plan.num_iterations;
+        check_errors(precision, num_iterations);
+        printf("  Algorithm: Bellard (Binary splitting) \n");
+        print_running_properties(precision, num_iterations, &plan);
+        Series_algorithm_bs(pi, &Bellard_series, num_iterations);
+        break;
+
+    case 8:
+        num_iterations = plan.num_iterations;
+        check_errors(precision, num_iterations);
+        printf("  Algorithm: Gauss Legendre (AGM) \n");
+        print_running_properties(precision, num_iterations, &plan);
+        GaussLegendre_algorithm(pi, num_iterations);
+        break;
+
+    case 9:
+        num_iterations = Machin_iterations(&Takano_formula, precision);
+        check_errors(precision, num_iterations);
+        printf("  Algorithm: Machin-like (Takano) \n");
+        print_running_properties(precision, num_iterations, &plan);
+        Machin_algorithm(pi, &Takano_formula, precision);
+        break;
+
+    case 10:
+        num_iterations = Machin_iterations(&Stormer_formula, precision);
+        check_errors(precision, num_iterations);
+        printf("  Algorithm: Machin-like (Stormer) \n");
+        print_running_properties(precision, num_iterations, &plan);
+        Machin_algorithm(pi, &Stormer_formula, precision);
+        break;
+
+    case 11:
+        num_iterations = plan.num_iterations;
+        check_errors(precision, num_iterations);
+        printf("  Algorithm: BBP (Fixed point) \n");
+        print_running_properties(precision, num_iterations, &plan);
+        Fixed_point_algorithm(pi, &BBP_fixed_series, num_iterations);
+        break;
+
+    case 12:
+        num_iterations = plan.num_iterations;
+        check_errors(precision, num_iterations);
+        printf("  Algorithm: Bellard (Fixed point) \n");
+        print_running_properties(precision, num_iterations, &plan);
+        Fixed_point_algorithm(pi, &Bellard_fixed_series, num_iterations);
+        break;
     
     default:
         printf("  Algorithm selected is not correct. Try with: \n");
@@ -77,17 +190,54 @@ void calculate_Pi(int algorithm, int precision){
         printf("      algorithm == 1 -> Bellard (First version) \n");
         printf("      algorithm == 2 -> Bellard (Last versoin)\n");
         printf("      algorithm == 3 -> Chudnovsky  \n");
+        printf("      algorithm == 4 -> Chudnovsky (Binary splitting) \n");
+        printf("      algorithm == 5 -> BBP (Binary splitting) \n");
+        printf("      algorithm == 6 -> Bellard (Binary splitting) \n");
+        printf("      algorithm == 7 -> BBP (Hex digits after position precision) \n");
+        printf("      algorithm == 8 -> Gauss Legendre (AGM) \n");
+        printf("      algorithm == 9 -> Machin-like (Takano) \n");
+        printf("      algorithm == 10 -> Machin-like (Stormer) \n");
+        printf("      algorithm == 11 -> BBP (Fixed point) \n");
+        printf("      algorithm == 12 -> Bellard (Fixed point) \n");
         printf("\n");
         exit(-1);
         break;
     }
+    if (!phase_recorded(PHASE_SERIES)) phase_end(PHASE_SERIES, 0, started);
 
     gettimeofday(&t2, NULL);
     execution_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
-    decimals_computed = check_decimals(pi);
-    mpfr_clear(pi);
-    printf("  Match the first %d decimals \n", decimals_computed);
+    if (get_manifest_file() != NULL){
+        decimals_computed = check_manifest(get_manifest_file(), pi, precision, 1);
+        printf("  Match the first %d decimals \n", decimals_computed);
+    } else if (precision <= REFERENCE_DECIMALS){
+        decimals_computed = check_decimals(pi, 1);
+        printf("  Match the first %d decimals \n", decimals_computed);
+        print_certified_decimals(&plan, decimals_computed);
+    } else if (get_hex_verification()){
+        //There is no reference for so many decimals, check some hex digits of the tail
+        decimals_computed = -1;
+        started = phase_begin();
+        hex_matches = check_hex_digits(pi, precision, 1);
+        hex_seconds = phase_begin() - started;
+        printf("  Hex spot checks passed: %d of %d (%f seconds, %.0f%% of the execution time) \n",
+                    hex_matches, HEX_SPOT_CHECKS, hex_seconds, 100 * hex_seconds / execution_time);
+    } else {
+        decimals_computed = -1;
+        printf("  There is no reference for so many decimals, check them with --verify=hex or --manifest=FILE \n");
+    }
     printf("  Execution time: %f seconds \n", execution_time);
+    if (get_output_file() != NULL){
+        started = phase_begin();
+        write_decimals(get_output_file(), pi, precision, 1);
+        phase_end(PHASE_OUTPUT, 0, started);
+        printf("  Decimals written to %s \n", get_output_file());
+    }
+
+    run_report_t run = {"Sequential", algorithm, precision, num_iterations, 1, 1, get_precision_tapering(), 
+                            precision_bits, execution_time, decimals_computed};
+    print_process_report(&run);
+    mpfr_clear(pi);
     printf("\n");
 }
 
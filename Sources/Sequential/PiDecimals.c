@@ -1,31 +1,52 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <mpfr.h>
 #include "../../Headers/Sequential/PiCalculator.h"
 #include "../../Headers/Common/Print_title.h"
+#include "../../Headers/Common/Options.h"
+#include "../../Headers/Common/Precision.h"
+#include "../../Headers/Common/Division_kernel.h"
+#include "../../Headers/Common/Output.h"
+#include "../../Headers/Common/Manifest.h"
+#include "../../Headers/Common/Check_hex_digits.h"
+#include "../../Headers/Common/Checkpoint.h"
+#include "../../Headers/Common/Report.h"
 
 
 int incorrect_params(char* exec_name){
     printf("  Number of params are not correct. Try with:\n");
-    printf("    %s algorithm precision \n", exec_name);
+    printf("    %s algorithm precision [options] \n", exec_name);
+    printf("\n");
+    print_options_usage();
     printf("\n");
 }
 
 int main(int argc, char **argv){    
 
-    print_PiDecimals_title();
-    printf("  Sequential version! \n");
-    printf("\n");
-
-    //Check the number of parameters are correct
-    if(argc != 3){
+    //Check the number of parameters are correct, the report format decides where the title goes
+    options_t options;
+    if(argc < 3 || parse_options(argc, argv, 3, &options) != 0){
+        print_PiDecimals_title();
         incorrect_params(argv[0]);
         exit(-1);
     }
+    set_report_format(options.report);
+
+    print_PiDecimals_title();
+    printf("  Sequential version! \n");
+    printf("\n");
 
     //Take algorithm and precision from params
     int algorithm = atoi(argv[1]);    
     int precision = atoi(argv[2]);
 
+    set_precision_tapering(options.taper);
+    set_division_kernel(options.kernel);
+    set_output_file(options.output);
+    set_manifest_file(options.manifest);
+    set_checkpoint_file(options.checkpoint, options.resume);
+    set_hex_verification(options.verify_hex);
+
     calculate_Pi(algorithm, precision);
 
     exit(0);
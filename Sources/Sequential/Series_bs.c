@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "../../Headers/Sequential/Series_bs.h"
+
+
+/************************************************************************************
+ * Rational series evaluation by binary splitting                                   *
+ * Any series whose terms are rational functions of n times a product of            *
+ * rational ratios can be described with four polynomials and evaluated with        *
+ * exact integers. There is only one full precision division at the end             *
+ *                                                                                  *
+ ************************************************************************************
+ * Series:                                                                          *
+ *                          a(n)     p(1) p(2)     p(n)                             *
+ *         S = SUMMATORY( ------ * ---- ---- ... ---- ),  n >= 0                    *
+ *                          b(n)     q(1) q(2)     q(n)                             *
+ *                                                                                  *
+ *      For a geometric series p(k) / q(k) is the constant ratio                    *
+ *                                                                                  *
+ ************************************************************************************
+ * Binary splitting of the range [a, b):                                            *
+ *                                                                                  *
+ *      Leaf (b = a + 1):                                                           *
+ *          P = p(a),   Q = q(a)                      (P = Q = 1 when a = 0)        *
+ *          B = b(a),   T = a(a) P                                                  *
+ *                                                                                  *
+ *      Merge (a < m < b):                                                          *
+ *          P(a, b) = P(a, m) P(m, b)                                               *
+ *          Q(a, b) = Q(a, m) Q(m, b)                                               *
+ *          B(a, b) = B(a, m) B(m, b)                                               *
+ *          T(a, b) = B(m, b) Q(m, b) T(a, m) + B(a, m) P(a, m) T(m, b)             *
+ *                                                                                  *
+ *      Result:                                                                     *
+ *                       T(0, n)                                                    *
+ *              S = -----------------                                               *
+ *                   B(0, n) Q(0, n)                                                *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * Bailey Borwein Plouffe formula:
+ *              1      120n^2 + 151n + 47
+ *    pi = SUM(---- ------------------------------------- )
+ *             16^n  512n^4 + 1024n^3 + 712n^2 + 194n + 15
+ */
+const series_t BBP_series = {
+    .a = {2, {47, 151, 120}},
+    .b = {4, {15, 194, 712, 1024, 512}},
+    .p = {0, {1}},
+    .q = {0, {16}},
+};
+
+/*
+ * Bellard formula, with the seven quotients and the 2^6 factor as a single fraction:
+ *             (-1)^n    a(n)
+ *    pi = SUM(------ -------- )
+ *             1024^n    b(n)
+ */
+const series_t Bellard_series = {
+    .a = {6, {285021, 3271617, 14990012, 35326200, 45382000, 30250000, 8200000}},
+    .b = {7, {90720, 2105280, 18251520, 79367680, 190400000, 255360000, 179200000, 51200000}},
+    .p = {0, {-1}},
+    .q = {0, {1024}},
+};
+
+
+/*
+ * Evaluates the polynomial in n using the Horner method
+ */
+void polynomial_eval(mpz_t result, const polynomial_t * poly, int n){
+    int i;
+    long coeff;
+
+    mpz_set_si(result, poly -> coeffs[poly -> degree]);
+    for(i = poly -> degree - 1; i >= 0; i--){
+        mpz_mul_ui(result, result, n);
+        coeff = poly -> coeffs[i];
+        if (coeff >= 0) mpz_add_ui(result, result, coeff);
+        else mpz_sub_ui(result, result, -coeff);
+    }
+}
+
+/*
+ * Computes P, Q, B and T for the single term n
+ */
+void Series_bs_leaf(const series_t * series, int n, mpz_t P, mpz_t Q, mpz_t B, mpz_t T){
+    if (n == 0){
+        mpz_set_ui(P, 1);
+        mpz_set_ui(Q, 1);
+    } else {
+        polynomial_eval(P, &series -> p, n);
+        polynomial_eval(Q, &series -> q, n);
+    }
+    polynomial_eval(B, &series -> b, n);
+    polynomial_eval(T, &series -> a, n);
+    mpz_mul(T, T, P);
+}
+
+/*
+ * Merges the right range (P2, Q2, B2, T2) into the left range (P, Q, B, T)
+ * The right range must start where the left one ends. T2 is overwritten
+ */
+void Series_bs_merge(mpz_t P, mpz_t Q, mpz_t B, mpz_t T, mpz_t P2, mpz_t Q2, mpz_t B2, mpz_t T2){
+    mpz_mul(T, T, B2);      // T = B2 Q2 T + B P T2
+    mpz_mul(T, T, Q2);
+    mpz_mul(T2, T2, B);
+    mpz_mul(T2, T2, P);
+    mpz_add(T, T, T2);
+    mpz_mul(P, P, P2);      // P = P P2
+    mpz_mul(Q, Q, Q2);      // Q = Q Q2
+    mpz_mul(B, B, B2);      // B = B B2
+}
+
+/*
+ * Computes P, Q, B and T for the range of terms [a, b)
+ */
+void Series_bs(const series_t * series, int a, int b, mpz_t P, mpz_t Q, mpz_t B, mpz_t T){
+    int m;
+    mpz_t P2, Q2, B2, T2;
+
+    if (b - a == 1){
+        Series_bs_leaf(series, a, P, Q, B, T);
+        return;
+    }
+
+    m = a + (b - a) / 2;
+    mpz_inits(P2, Q2, B2, T2, NULL);
+    Series_bs(series, a, m, P, Q, B, T);
+    Series_bs(series, m, b, P2, Q2, B2, T2);
+    Series_bs_merge(P, Q, B, T, P2, Q2, B2, T2);
+    mpz_clears(P2, Q2, B2, T2, NULL);
+}
+
+/*
+ * Computes the value of the series from Q, B and T with the precision of result.
+ * B is overwritten
+ */
+void Series_bs_value(mpfr_t result, mpz_t Q, mpz_t B, mpz_t T){
+    mpz_mul(B, B, Q);
+    mpfr_set_z(result, T, MPFR_RNDN);
+    mpfr_div_z(result, result, B, MPFR_RNDN);
+}
+
+/*
+ * Sequential evaluation of the first num_iterations terms of a series
+ * with binary splitting. Single thread implementation
+ */
+void Series_algorithm_bs(mpfr_t result, const series_t * series, int num_iterations){
+    mpz_t P, Q, B, T;
+
+    mpz_inits(P, Q, B, T, NULL);
+    Series_bs(series, 0, num_iterations, P, Q, B, T);
+    Series_bs_value(result, Q, B, T);
+
+    //Clear memory
+    mpz_clears(P, Q, B, T, NULL);
+}
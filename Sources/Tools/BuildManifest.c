@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <mpfr.h>
+#include "../../Headers/Common/Manifest.h"
+#include "../../Headers/Common/Check_decimals.h"
+
+
+/*
+ * Builds the reference manifest of a trusted decimals file, written as the
+ * --output option does (integer part, decimal point and decimals)
+ */
+int main(int argc, char **argv){
+    long length, start, end;
+    int num_threads;
+    char * digits;
+    manifest_t manifest;
+
+    if (argc < 3 || argc > 5){
+        printf("  Number of params are not correct. Try with:\n");
+        printf("    %s decimals_file manifest_file [chunk_digits] [num_threads]\n", argv[0]);
+        printf("\n");
+        exit(-1);
+    }
+    manifest.chunk_digits = (argc > 3) ? atol(argv[3]) : MANIFEST_CHUNK_DIGITS;
+    num_threads = (argc > 4 && atoi(argv[4]) > 0) ? atoi(argv[4]) : 1;
+    if (manifest.chunk_digits <= 0){
+        printf("  Chunk digits should be greater than cero. \n\n");
+        exit(-1);
+    }
+
+    digits = map_file(argv[1], &length);
+    if (digits == NULL){
+        printf("  %s not found \n\n", argv[1]);
+        exit(-1);
+    }
+
+    //The decimals go from the decimal point to the first char that is not a digit
+    start = 0;
+    while (start < length && digits[start] != '.') start++;
+    if (start == length){
+        printf("  %s has no decimal point \n\n", argv[1]);
+        exit(-1);
+    }
+    start++;
+    for(end = start; end < length && digits[end] >= '0' && digits[end] <= '9'; end++);
+
+    manifest.num_decimals = end - start;
+    manifest.num_chunks = (manifest.num_decimals + manifest.chunk_digits - 1) / manifest.chunk_digits;
+    manifest.hashes = malloc((manifest.num_chunks + 1) * sizeof(uint64_t));
+    hash_chunks(digits + start, manifest.num_decimals, manifest.chunk_digits, manifest.hashes, num_threads);
+    if (write_manifest(argv[2], &manifest) != 0){
+        printf("  The manifest could not be written to %s \n\n", argv[2]);
+        exit(-1);
+    }
+    printf("  Manifest of %ld decimals (%ld chunks of %ld) written to %s \n", manifest.num_decimals,
+                manifest.num_chunks, manifest.chunk_digits, argv[2]);
+
+    //Clear memory
+    free_manifest(&manifest);
+    unmap_file(digits, length);
+
+    exit(0);
+}
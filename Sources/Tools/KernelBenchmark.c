@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <mpfr.h>
+#include "../../Headers/Sequential/BBP.h"
+#include "../../Headers/Sequential/Bellard_v1.h"
+#include "../../Headers/Sequential/Chudnovsky_v2.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define KERNEL_TSC
+#include <x86intrin.h>
+#endif
+
+#define KERNEL_MIN_BITS 256                 // The precisions go from it to max_bits multiplying by 4
+#define KERNEL_MAX_BITS 1048576
+#define KERNEL_REPETITIONS 7
+#define KERNEL_MIN_SECONDS 0.005            // Minimum length of each repetition
+#define KERNEL_MAX_TERMS 1048576
+#define KERNEL_WARMUP_TERMS 16
+#define CHUDNOVSKY_B 545140134              // Constants of the Chudnovsky recurrences
+#define CHUDNOVSKY_C 640320
+
+
+/************************************************************************************
+ * Micro-benchmark of the iteration kernels and the recurrence updates              *
+ * Each kernel computes one term with the operands of a series at some precision    *
+ * and term index, without the rest of a run (start-up, planning, verification).    *
+ * After a warm-up, the number of terms of a repetition grows until it lasts        *
+ * KERNEL_MIN_SECONDS, and the median of the repetitions is reported as             *
+ * nanoseconds and cycles (of the time stamp counter, if the CPU has one) per term  *
+ *                                                                                  *
+ ************************************************************************************/
+
+typedef struct {
+    mpfr_t pi, dep_m, quotient, jump, one, a, b, c, d, e, f, g, aux;
+    mpfr_t dep_a, dep_b, dep_c, factor_c, dividend, divisor;
+} kernel_state_t;
+
+typedef struct {
+    const char * name;
+    void (* term)(kernel_state_t * state, int n);
+} kernel_t;
+
+
+void BBP_iteration_kernel(kernel_state_t * s, int n){
+    BBP_iteration(s -> pi, n, s -> dep_m, s -> a, s -> b, s -> c, s -> d, s -> aux);
+}
+
+void BBP_update_kernel(kernel_state_t * s, int n){
+    (void) n;
+    mpfr_mul(s -> dep_m, s -> dep_m, s -> quotient, MPFR_RNDN);
+}
+
+void Bellard_iteration_kernel(kernel_state_t * s, int n){
+    Bellard_iteration_v1(s -> pi, n, s -> dep_m, s -> a, s -> b, s -> c, s -> d, s -> e, s -> f, s -> g, s -> aux, 4 * n, 10 * n);
+}
+
+void Bellard_v1_update_kernel(kernel_state_t * s, int n){        // Sequential and MPI back ends
+    (void) n;
+    mpfr_mul(s -> dep_m, s -> dep_m, s -> jump, MPFR_RNDN);
+    mpfr_neg(s -> dep_m, s -> dep_m, MPFR_RNDN);
+}
+
+void Bellard_v1_div_update_kernel(kernel_state_t * s, int n){    // OMP back end
+    (void) n;
+    mpfr_div_2ui(s -> dep_m, s -> dep_m, 10, MPFR_RNDN);
+    mpfr_neg(s -> dep_m, s -> dep_m, MPFR_RNDN);
+}
+
+void Bellard_update_kernel(kernel_state_t * s, int n){
+    mpfr_mul_2exp(s -> dep_m, s -> one, 10 * (n + 1), MPFR_RNDN);
+    mpfr_div(s -> dep_m, s -> one, s -> dep_m, MPFR_RNDN);
+    if ((n + 1) % 2 != 0) mpfr_neg(s -> dep_m, s -> dep_m, MPFR_RNDN);
+}
+
+void Chudnovsky_iteration_kernel(kernel_state_t * s, int n){
+    Chudnovsky_iteration(s -> pi, n, s -> dep_a, s -> dep_b, s -> dep_c, s -> aux);
+}
+
+void Chudnovsky_update_a_kernel(kernel_state_t * s, int n){
+    Chudnovsky_update_a(s -> dep_a, n, s -> dividend, s -> divisor);
+}
+
+void Chudnovsky_update_b_kernel(kernel_state_t * s, int n){
+    (void) n;
+    mpfr_mul(s -> dep_b, s -> dep_b, s -> factor_c, MPFR_RNDN);
+}
+
+void Chudnovsky_update_c_kernel(kernel_state_t * s, int n){
+    (void) n;
+    mpfr_add_ui(s -> dep_c, s -> dep_c, CHUDNOVSKY_B, MPFR_RNDN);
+}
+
+static const kernel_t kernels[] = {
+    {"BBP_iteration", BBP_iteration_kernel},
+    {"BBP_update", BBP_update_kernel},
+    {"Bellard_iteration_v1", Bellard_iteration_kernel},
+    {"Bellard_v1_update", Bellard_v1_update_kernel},
+    {"Bellard_v1_div_update", Bellard_v1_div_update_kernel},
+    {"Bellard_update", Bellard_update_kernel},
+    {"Chudnovsky_iteration", Chudnovsky_iteration_kernel},
+    {"Chudnovsky_update_a", Chudnovsky_update_a_kernel},
+    {"Chudnovsky_update_b", Chudnovsky_update_b_kernel},
+    {"Chudnovsky_update_c", Chudnovsky_update_c_kernel},
+};
+
+#define NUM_KERNELS ((int) (sizeof(kernels) / sizeof(kernel_t)))
+
+static const int term_indices[] = {10, 1000, 100000};
+
+#define NUM_TERM_INDICES ((int) (sizeof(term_indices) / sizeof(int)))
+
+
+/*
+ * Sets the operands to values that use all their bits, so every repetition
+ * starts from the same state
+ */
+void set_kernel_state(kernel_state_t * s){
+    mpfr_set_ui(s -> pi, 0, MPFR_RNDN);
+    mpfr_set_ui(s -> dep_m, 1, MPFR_RNDN);
+    mpfr_div_ui(s -> dep_m, s -> dep_m, 3, MPFR_RNDN);
+    mpfr_set_ui(s -> dep_a, 1, MPFR_RNDN);
+    mpfr_div_ui(s -> dep_a, s -> dep_a, 7, MPFR_RNDN);
+    mpfr_set_ui(s -> dep_b, 1, MPFR_RNDN);
+    mpfr_div_ui(s -> dep_b, s -> dep_b, 11, MPFR_RNDN);
+    mpfr_set_ui(s -> dep_c, 13591409, MPFR_RNDN);
+}
+
+void init_kernel_state(kernel_state_t * s, long precision_bits){
+    mpfr_inits2(precision_bits, s -> pi, s -> dep_m, s -> quotient, s -> jump, s -> one, s -> a, s -> b, s -> c, s -> d,
+                    s -> e, s -> f, s -> g, s -> aux, s -> dep_a, s -> dep_b, s -> dep_c, s -> factor_c,
+                    s -> dividend, s -> divisor, NULL);
+    mpfr_set_d(s -> quotient, 0.0625, MPFR_RNDN);
+    mpfr_set_ui(s -> jump, 1, MPFR_RNDN);
+    mpfr_div_ui(s -> jump, s -> jump, 1024, MPFR_RNDN);
+    mpfr_set_ui(s -> one, 1, MPFR_RNDN);
+    mpfr_set_si(s -> factor_c, -CHUDNOVSKY_C, MPFR_RNDN);
+    mpfr_pow_ui(s -> factor_c, s -> factor_c, 3, MPFR_RNDN);
+    set_kernel_state(s);
+}
+
+void clear_kernel_state(kernel_state_t * s){
+    mpfr_clears(s -> pi, s -> dep_m, s -> quotient, s -> jump, s -> one, s -> a, s -> b, s -> c, s -> d,
+                    s -> e, s -> f, s -> g, s -> aux, s -> dep_a, s -> dep_b, s -> dep_c, s -> factor_c,
+                    s -> dividend, s -> divisor, NULL);
+}
+
+double kernel_time(){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1.e9;
+}
+
+unsigned long long kernel_cycles(){
+#ifdef KERNEL_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+int compare_doubles(const void * x, const void * y){
+    double a = * (const double *) x, b = * (const double *) y;
+    return (a > b) - (a < b);
+}
+
+/*
+ * Median seconds and cycles per term of the kernel from the term index n on
+ */
+void measure_kernel(const kernel_t * kernel, kernel_state_t * state, int n, int repetitions,
+                        double * seconds_per_term, double * cycles_per_term){
+    int i, repetition, num_terms;
+    double start, elapsed, * seconds, * cycles;
+    unsigned long long start_cycles;
+
+    for(i = 0; i < KERNEL_WARMUP_TERMS; i++) kernel -> term(state, n + i);
+
+    //Terms of a repetition
+    for(num_terms = 1; ; num_terms *= 2){
+        set_kernel_state(state);
+        start = kernel_time();
+        for(i = 0; i < num_terms; i++) kernel -> term(state, n + i);
+        elapsed = kernel_time() - start;
+        if (elapsed >= KERNEL_MIN_SECONDS || num_terms >= KERNEL_MAX_TERMS) break;
+    }
+
+    seconds = malloc(repetitions * sizeof(double));
+    cycles = malloc(repetitions * sizeof(double));
+    for(repetition = 0; repetition < repetitions; repetition++){
+        set_kernel_state(state);
+        start = kernel_time();
+        start_cycles = kernel_cycles();
+        for(i = 0; i < num_terms; i++) kernel -> term(state, n + i);
+        cycles[repetition] = (double) (kernel_cycles() - start_cycles) / num_terms;
+        seconds[repetition] = (kernel_time() - start) / num_terms;
+    }
+    qsort(seconds, repetitions, sizeof(double), compare_doubles);
+    qsort(cycles, repetitions, sizeof(double), compare_doubles);
+    * seconds_per_term = seconds[repetitions / 2];
+    * cycles_per_term = cycles[repetitions / 2];
+
+    free(seconds);
+    free(cycles);
+}
+
+int main(int argc, char **argv){
+    int k, t, repetitions;
+    long precision_bits, max_bits;
+    double seconds_per_term, cycles_per_term;
+    const char * only;
+    kernel_state_t state;
+
+    if (argc > 4){
+        printf("  Number of params are not correct. Try with:\n");
+        printf("    %s [max_bits] [repetitions] [kernel]\n", argv[0]);
+        printf("\n");
+        exit(-1);
+    }
+    max_bits = (argc > 1) ? atol(argv[1]) : KERNEL_MAX_BITS;
+    repetitions = (argc > 2) ? atoi(argv[2]) : KERNEL_REPETITIONS;
+    only = (argc > 3) ? argv[3] : NULL;
+    if (max_bits < KERNEL_MIN_BITS || repetitions <= 0){
+        printf("  The precision should be at least %d bits and the repetitions greater than cero. \n\n", KERNEL_MIN_BITS);
+        exit(-1);
+    }
+
+    printf("  %-22s %10s %8s %14s %14s \n", "Kernel", "Bits", "Term", "ns/term", "cycles/term");
+    for(k = 0; k < NUM_KERNELS; k++){
+        if (only != NULL && strcmp(only, kernels[k].name) != 0) continue;
+        for(precision_bits = KERNEL_MIN_BITS; precision_bits <= max_bits; precision_bits *= 4){
+            init_kernel_state(&state, precision_bits);
+            for(t = 0; t < NUM_TERM_INDICES; t++){
+                measure_kernel(&kernels[k], &state, term_indices[t], repetitions, &seconds_per_term, &cycles_per_term);
+#ifdef KERNEL_TSC
+                printf("  %-22s %10ld %8d %14.1f %14.0f \n", kernels[k].name, precision_bits, term_indices[t],
+                            seconds_per_term * 1.e9, cycles_per_term);
+#else
+                printf("  %-22s %10ld %8d %14.1f %14s \n", kernels[k].name, precision_bits, term_indices[t],
+                            seconds_per_term * 1.e9, "-");
+#endif
+            }
+            clear_kernel_state(&state);
+        }
+    }
+    mpfr_free_cache();
+
+    exit(0);
+}
@@ -0,0 +1,225 @@
+#!/bin/bash
+
+# Scaling benchmark of PiDecimalsMPFR: sweeps algorithm x precision x threads x processes,
+# repeats every run to take the median time and writes the dataset (CSV and JSON) and
+# a profile of timing ratios per algorithm, like Resources/working_ratios.txt.
+# One process runs parallelOMP.x (calculate_Pi_OMP), more run parallelMPI.x (calculate_Pi_MPI)
+
+algorithms="3,4"
+step=10000
+points=4
+threads="1,2,4"
+procs="1"
+repeat=3
+min_efficiency=0.5
+weak=0
+output="Benchmark"
+run_timeout=600
+mpirun_cmd="mpirun"
+RED_OUTPUT="tput setaf 1"
+RESET_OUTPUT="tput sgr0"
+
+errors(){
+    echo "params are not correct. They should be: ./benchmark.sh [options]"
+    echo "  --algorithms=LIST        algorithm ids (default $algorithms)"
+    echo "  --step=DECIMALS          the precisions are step, 2 step... (default $step)"
+    echo "  --points=N               number of precisions (default $points)"
+    echo "  --threads=LIST           threads per process (default $threads)"
+    echo "  --procs=LIST             MPI processes, 1 runs the OMP version (default $procs)"
+    echo "  --repeat=N               runs of every configuration (default $repeat)"
+    echo "  --min-efficiency=E       flag the speed-ups below E times the workers (default $min_efficiency)"
+    echo "  --weak                   also weak scaling: the precision grows with the workers"
+    echo "  --output=DIR             directory of the results (default $output)"
+    echo "  --timeout=SECONDS        time limit of every run (default $run_timeout)"
+    echo "  --mpirun=COMMAND         launcher of the MPI runs (default $mpirun_cmd)"
+    echo "  The programs should be compiled before: ./compile.sh OMP and ./compile.sh MPI"
+    exit 1
+}
+
+#CHECK PARAMS
+for param in "$@"; do
+    case "$param" in
+        --algorithms=*) algorithms="${param#*=}" ;;
+        --step=*) step="${param#*=}" ;;
+        --points=*) points="${param#*=}" ;;
+        --threads=*) threads="${param#*=}" ;;
+        --procs=*) procs="${param#*=}" ;;
+        --repeat=*) repeat="${param#*=}" ;;
+        --min-efficiency=*) min_efficiency="${param#*=}" ;;
+        --weak) weak=1 ;;
+        --output=*) output="${param#*=}" ;;
+        --timeout=*) run_timeout="${param#*=}" ;;
+        --mpirun=*) mpirun_cmd="${param#*=}" ;;
+        *) errors ;;
+    esac
+done
+
+IFS=',' read -r -a algorithm_list <<< "$algorithms"
+IFS=',' read -r -a thread_list <<< "$threads"
+IFS=',' read -r -a proc_list <<< "$procs"
+if [[ ! "$step" =~ ^[0-9]+$ || ! "$points" =~ ^[0-9]+$ || ! "$repeat" =~ ^[0-9]+$ || "$step" -eq 0 || "$points" -eq 0 || "$repeat" -eq 0 ]]; then
+    errors
+fi
+for list in "${algorithm_list[@]}" "${thread_list[@]}" "${proc_list[@]}"; do
+    if [[ ! "$list" =~ ^[0-9]+$ ]]; then
+        errors
+    fi
+done
+for num_procs in "${proc_list[@]}"; do
+    if [ "$num_procs" -eq 0 ]; then
+        errors
+    elif [[ "$num_procs" -eq 1 && ! -x ./parallelOMP.x ]]; then
+        echo "./parallelOMP.x not found, compile it with ./compile.sh OMP"
+        exit 1
+    elif [[ "$num_procs" -gt 1 && ! -x ./parallelMPI.x ]]; then
+        echo "./parallelMPI.x not found, compile it with ./compile.sh MPI"
+        exit 1
+    fi
+done
+if [ ! -x ./parallelOMP.x ]; then
+    echo "./parallelOMP.x not found, compile it with ./compile.sh OMP (it runs the baselines of one worker)"
+    exit 1
+fi
+
+mkdir -p "$output"
+csv="$output/results.csv"
+json="$output/results.json"
+echo "mode,algorithm,precision,threads,procs,workers,median_seconds,runs,speed_up,efficiency,flag" > "$csv"
+
+#RUN A CONFIGURATION: prints the median execution time of the runs that finished, empty if none
+median_time(){
+    local algorithm="$1" precision="$2" num_threads="$3" num_procs="$4" run time times=""
+
+    for ((run = 0; run < repeat; run++)); do
+        if [ "$num_procs" -eq 1 ]; then
+            time=$(timeout "$run_timeout" ./parallelOMP.x "$algorithm" "$precision" "$num_threads" 2>/dev/null \
+                    | grep "Execution time" | awk '{print $3}')
+        else
+            time=$(timeout "$run_timeout" $mpirun_cmd -np "$num_procs" ./parallelMPI.x "$algorithm" "$precision" "$num_threads" 2>/dev/null \
+                    | grep "Execution time" | awk '{print $3}')
+        fi
+        if [ -n "$time" ]; then
+            times="$times $time"
+        fi
+    done
+    echo $times | tr ' ' '\n' | sort -g | awk 'NF {t[n++] = $1} END {if (n > 0) print (n % 2) ? t[int(n / 2)] : (t[n / 2 - 1] + t[n / 2]) / 2}'
+}
+
+#ADD A RESULT: speed-up and efficiency over the baseline of one worker
+add_result(){
+    local mode="$1" algorithm="$2" precision="$3" num_threads="$4" num_procs="$5" time="$6" baseline="$7"
+    local workers=$((num_threads * num_procs)) speed_up="" efficiency="" flag=""
+
+    if [[ -n "$time" && -n "$baseline" ]]; then
+        if [ "$mode" = "weak" ]; then
+            speed_up=$(awk -v b="$baseline" -v t="$time" -v w="$workers" 'BEGIN {printf "%.3f", w * b / t}')
+        else
+            speed_up=$(awk -v b="$baseline" -v t="$time" 'BEGIN {printf "%.3f", b / t}')
+        fi
+        efficiency=$(awk -v s="$speed_up" -v w="$workers" 'BEGIN {printf "%.3f", s / w}')
+        flag=$(awk -v e="$efficiency" -v m="$min_efficiency" 'BEGIN {if (e < m) print "low"}')
+    elif [ -z "$time" ]; then
+        flag="failed"
+    fi
+    echo "$mode,$algorithm,$precision,$num_threads,$num_procs,$workers,$time,$repeat,$speed_up,$efficiency,$flag" >> "$csv"
+    printf "  %-6s algorithm %-3s %9s decimals %4s threads %4s procs: %12s seconds  speed-up %7s  %s\n" \
+            "$mode" "$algorithm" "$precision" "$num_threads" "$num_procs" "${time:--}" "${speed_up:--}" "$flag"
+}
+
+#STRONG SCALING: every precision with every number of workers
+declare -A times
+for algorithm in "${algorithm_list[@]}"; do
+    for ((point = 1; point <= points; point++)); do
+        precision=$((point * step))
+        times["$algorithm,$precision,1"]=$(median_time "$algorithm" "$precision" 1 1)
+        add_result strong "$algorithm" "$precision" 1 1 "${times[$algorithm,$precision,1]}" "${times[$algorithm,$precision,1]}"
+        for num_procs in "${proc_list[@]}"; do
+            for num_threads in "${thread_list[@]}"; do
+                if [ $((num_threads * num_procs)) -le 1 ]; then
+                    continue
+                fi
+                time=$(median_time "$algorithm" "$precision" "$num_threads" "$num_procs")
+                add_result strong "$algorithm" "$precision" "$num_threads" "$num_procs" "$time" "${times[$algorithm,$precision,1]}"
+                workers=$((num_threads * num_procs))
+                best="${times[$algorithm,$precision,$workers]}"
+                if [[ -n "$time" && ( -z "$best" || $(awk -v t="$time" -v b="$best" 'BEGIN {print (t < b)}') -eq 1 ) ]]; then
+                    times["$algorithm,$precision,$workers"]="$time"
+                fi
+            done
+        done
+    done
+done
+
+#WEAK SCALING: the first precision per worker
+if [ "$weak" -eq 1 ]; then
+    for algorithm in "${algorithm_list[@]}"; do
+        baseline="${times[$algorithm,$step,1]}"
+        for num_procs in "${proc_list[@]}"; do
+            for num_threads in "${thread_list[@]}"; do
+                workers=$((num_threads * num_procs))
+                if [ "$workers" -le 1 ]; then
+                    continue
+                fi
+                time=$(median_time "$algorithm" $((workers * step)) "$num_threads" "$num_procs")
+                add_result weak "$algorithm" $((workers * step)) "$num_threads" "$num_procs" "$time" "$baseline"
+            done
+        done
+    done
+fi
+
+#DATASET AS JSON
+awk -F',' 'NR == 1 {for (i = 1; i <= NF; i++) key[i] = $i; next}
+    {
+        printf "%s\n  {", (NR == 2) ? "[" : ","
+        for (i = 1; i <= NF; i++){
+            value = (i == 1 || i == NF) ? "\"" $i "\"" : (($i == "") ? "null" : $i)
+            printf "\"%s\": %s%s", key[i], value, (i < NF) ? ", " : ""
+        }
+        printf "}"
+    }
+    END {print (NR > 1) ? "\n]" : "[]"}' "$csv" > "$json"
+
+#PROFILE OF EVERY ALGORITHM: row w = w workers, column c = (c + 1) step decimals,
+#timing ratio over one worker (the best split of the workers), 0 if not measured.
+#The "# seconds" rows are the times of one worker of all the algorithms measured
+max_workers=1
+for num_procs in "${proc_list[@]}"; do
+    for num_threads in "${thread_list[@]}"; do
+        if [ $((num_threads * num_procs)) -gt "$max_workers" ]; then
+            max_workers=$((num_threads * num_procs))
+        fi
+    done
+done
+for algorithm in "${algorithm_list[@]}"; do
+    profile="$output/working_ratios_$algorithm.txt"
+    echo "# step $step" > "$profile"
+    for measured in "${algorithm_list[@]}"; do
+        row=""
+        for ((point = 1; point <= points; point++)); do
+            row="$row"$(awk -v t="${times[$measured,$((point * step)),1]}" 'BEGIN {printf "\t%.6f", (t > 0) ? t : 0}')
+        done
+        echo "# seconds $measured$row" >> "$profile"
+    done
+    for ((workers = 1; workers <= max_workers; workers++)); do
+        row=""
+        for ((point = 1; point <= points; point++)); do
+            precision=$((point * step))
+            row="$row"$(awk -v t="${times[$algorithm,$precision,$workers]}" -v b="${times[$algorithm,$precision,1]}" \
+                    'BEGIN {printf "%.3f\t", (t > 0 && b > 0) ? t / b : 0}')
+        done
+        echo "${row%$'\t'}" >> "$profile"
+    done
+done
+
+#SUMMARY
+low=$(grep -c ",low$" "$csv")
+failed=$(grep -c ",failed$" "$csv")
+echo ""
+echo "  Results: $csv, $json"
+echo "  Profiles: $output/working_ratios_<algorithm>.txt (use them with --profile=FILE)"
+if [ "$low" -gt 0 ] || [ "$failed" -gt 0 ]; then
+    ${RED_OUTPUT}
+    echo "  $low configurations below an efficiency of $min_efficiency, $failed failed:"
+    ${RESET_OUTPUT}
+    grep ",low$\|,failed$" "$csv" | awk -F',' '{printf "    %s algorithm %s, %s decimals, %s threads x %s procs: speed-up %s\n", $1, $2, $3, $4, $5, ($9 == "") ? "-" : $9}'
+fi
@@ -0,0 +1,84 @@
+#!/bin/bash
+
+# Check of the distributed output of PiDecimalsMPFR: writes the decimals with
+# parallelMPI.x for small precisions and numbers of processes, so the boundaries of
+# the segments fall on the decimal point and around it, and compares every file
+# with the one written by parallelOMP.x
+
+algorithm=9
+max_precision=12
+procs="2,3,4"
+mpirun_cmd="mpirun"
+output="Check_output"
+RED_OUTPUT="tput setaf 1"
+RESET_OUTPUT="tput sgr0"
+
+errors(){
+    echo "params are not correct. They should be: ./check_output.sh [options]"
+    echo "  --algorithm=N            algorithm id (default $algorithm)"
+    echo "  --max-precision=N        the precisions are 1, 2... N (default $max_precision)"
+    echo "  --procs=LIST             MPI processes (default $procs)"
+    echo "  --mpirun=COMMAND         launcher of the MPI runs (default $mpirun_cmd)"
+    echo "  --output=DIR             directory of the files (default $output)"
+    echo "  The programs should be compiled before: ./compile.sh OMP and ./compile.sh MPI"
+    exit 1
+}
+
+#CHECK PARAMS
+for param in "$@"; do
+    case "$param" in
+        --algorithm=*) algorithm="${param#*=}" ;;
+        --max-precision=*) max_precision="${param#*=}" ;;
+        --procs=*) procs="${param#*=}" ;;
+        --mpirun=*) mpirun_cmd="${param#*=}" ;;
+        --output=*) output="${param#*=}" ;;
+        *) errors ;;
+    esac
+done
+
+IFS=',' read -r -a proc_list <<< "$procs"
+if [[ ! "$algorithm" =~ ^[0-9]+$ || ! "$max_precision" =~ ^[0-9]+$ || "$max_precision" -eq 0 ]]; then
+    errors
+fi
+for num_procs in "${proc_list[@]}"; do
+    if [[ ! "$num_procs" =~ ^[0-9]+$ || "$num_procs" -eq 0 ]]; then
+        errors
+    fi
+done
+if [[ ! -x ./parallelOMP.x || ! -x ./parallelMPI.x ]]; then
+    echo "./parallelOMP.x or ./parallelMPI.x not found, compile them with ./compile.sh OMP and ./compile.sh MPI"
+    exit 1
+fi
+
+mkdir -p "$output"
+checked=0
+failed=0
+for ((precision = 1; precision <= max_precision; precision++)); do
+    reference="$output/reference_$precision.txt"
+    if ! ./parallelOMP.x "$algorithm" "$precision" 1 --output="$reference" > /dev/null 2>&1; then
+        echo "  $precision decimals: the reference could not be written"
+        continue
+    fi
+    for num_procs in "${proc_list[@]}"; do
+        file="$output/mpi_${precision}_$num_procs.txt"
+        rm -f "$file"
+        if ! $mpirun_cmd -np "$num_procs" ./parallelMPI.x "$algorithm" "$precision" 1 --output="$file" > /dev/null 2>&1; then
+            echo "  $precision decimals, $num_procs processes: not run (too few iterations for the processes)"
+            continue
+        fi
+        checked=$((checked + 1))
+        if ! cmp -s "$reference" "$file"; then
+            failed=$((failed + 1))
+            ${RED_OUTPUT}
+            echo "  $precision decimals, $num_procs processes: $file differs from $reference"
+            ${RESET_OUTPUT}
+        fi
+    done
+done
+
+#SUMMARY
+echo ""
+echo "  $checked files checked, $failed differ"
+if [ "$failed" -gt 0 ]; then
+    exit 1
+fi
@@ -11,6 +11,8 @@ errors(){
     echo "  if program is Sequential -> compile sequential version of PiDecimalsMPFR"
     echo "  if program is OMP -> compile parallel OMP version of PiDecimalsMPFR "
     echo "  if program is MPI -> compile parallel bybrid OMP and MPI version of PiDecimalsMPFR "
+    echo "  if program is Manifest -> compile the tool that builds reference manifests "
+    echo "  if program is Kernels -> compile the micro-benchmark of the iteration kernels "
     exit 1
 }
 
@@ -20,13 +22,18 @@ if [ "$#" -ne 1 ]; then
 fi
 
 if [ "$program" = "Sequential" ]; then
-	error=$(gcc -o sequential.x Sources/Sequential/*.c Sources/Common/*.c -lmpfr -lgmp 2>&1 1>/dev/null)
+	error=$(gcc -O2 -o sequential.x Sources/Sequential/*.c Sources/Common/*.c -lmpfr -lgmp -lm -pthread 2>&1 1>/dev/null)
 
 elif [ "$program" = "OMP" ]; then
-	error=$(gcc -fopenmp -o parallelOMP.x Sources/OMP/*.c Sources/Sequential/BBP*.c Sources/Sequential/Bellard*.c Sources/Sequential/Chudnovsky*.c Sources/Common/*.c -lmpfr -lgmp 2>&1 1>/dev/null)
+	error=$(gcc -O2 -fopenmp -o parallelOMP.x Sources/OMP/*.c Sources/Sequential/BBP*.c Sources/Sequential/Bellard*.c Sources/Sequential/Chudnovsky*.c Sources/Sequential/Series*.c Sources/Sequential/Machin*.c Sources/Sequential/Fixed*.c Sources/Common/*.c -lmpfr -lgmp -lm -pthread 2>&1 1>/dev/null)
 
 elif [ "$program" = "MPI" ]; then 
-	error=$(mpicc -fopenmp -o parallelMPI.x Sources/MPI/*.c Sources/Sequential/BBP*.c Sources/Sequential/Bellard*.c Sources/Sequential/Chudnovsky*.c Sources/Common/*.c -lmpfr -lgmp -lm 2>&1 1>/dev/null)
+	error=$(mpicc -O2 -fopenmp -o parallelMPI.x Sources/MPI/*.c Sources/Sequential/BBP*.c Sources/Sequential/Bellard*.c Sources/Sequential/Chudnovsky*.c Sources/Sequential/Series*.c Sources/Sequential/Machin*.c Sources/Sequential/Fixed*.c Sources/Common/*.c -lmpfr -lgmp -lm -pthread 2>&1 1>/dev/null)
+
+elif [ "$program" = "Manifest" ]; then 
+	error=$(gcc -O2 -fopenmp -o manifest.x Sources/Tools/BuildManifest.c Sources/Common/Manifest.c Sources/Common/Xxhash.c Sources/Common/Check_decimals.c Sources/Common/Decimal_conversion.c Sources/Common/Report.c -lmpfr -lgmp -lm 2>&1 1>/dev/null)
+elif [ "$program" = "Kernels" ]; then 
+	error=$(gcc -O2 -fopenmp -o kernels.x Sources/Tools/KernelBenchmark.c Sources/Sequential/BBP*.c Sources/Sequential/Bellard_v1.c Sources/Sequential/Chudnovsky.c Sources/Common/*.c -lmpfr -lgmp -lm -pthread 2>&1 1>/dev/null)
 else
     errors
 fi